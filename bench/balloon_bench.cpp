@@ -0,0 +1,1215 @@
+// Benchmark Entry Point
+
+#include <gamelib/collision_world.h>
+#include <gamelib/integrator.h>
+#include <gamelib/integrator_kernel.h>
+#include <gamelib/keycodes.h>
+#include <gamelib/physics_object.h>
+#include <gamelib/triple_buffer.h>
+#include <gamelib/vector2.h>
+
+#include <balloon/balloon.h>
+#include <balloon/rope.h>
+#include <balloon/rope_chain.h>
+
+#include <autopilot.h>
+#include <flight_recording.h>
+#include <physics_stepper.h>
+#include <scene.h>
+#include <terrain.h>
+#include <terrain_generator.h>
+#include <world_state.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <random>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+namespace
+{
+    /**
+     * @brief the number of heap allocations made by the bench so far, counted by the replacement
+     * operator new so that the step path can be checked for allocations
+     */
+    std::atomic<size_t> allocation_count(0);
+}
+
+void* operator new(const size_t size)
+{
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+
+    void* const memory = std::malloc(size > 0 ? size : 1);
+    if (memory == nullptr)
+    {
+        throw std::bad_alloc();
+    }
+
+    return memory;
+}
+
+void* operator new[](const size_t size)
+{
+    return operator new(size);
+}
+
+void operator delete(void* memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete[](void* memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void* memory, const size_t) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete[](void* memory, const size_t) noexcept
+{
+    std::free(memory);
+}
+
+namespace
+{
+    /**
+     * @brief sink for benchmark results so that the compiler cannot remove the benchmarked work
+     */
+    volatile double result_sink = 0.0;
+
+    /**
+     * @brief a single benchmark result, where a lower value is always better
+     */
+    struct BenchResult
+    {
+        std::string name;
+        double value;
+        std::string unit;
+    };
+
+    /**
+     * @brief the fastest result of each benchmark over every round so far, printed, written out and
+     * compared once every round has run
+     */
+    std::vector<BenchResult> bench_results;
+
+    /**
+     * @brief the round of benchmarks being run, where only the first round prints details other than
+     * the timings
+     */
+    size_t bench_round = 0;
+
+    /**
+     * @brief keeps a result, or the faster of the result and the one kept from an earlier round
+     */
+    void record_result(
+        const std::string& name,
+        const double value,
+        const std::string& unit)
+    {
+        for (BenchResult& result : bench_results)
+        {
+            if (result.name == name)
+            {
+                result.value = std::min(result.value, value);
+                return;
+            }
+        }
+
+        bench_results.push_back({ name, value, unit });
+    }
+
+    /**
+     * @brief the number of timed samples taken of each benchmark in each round
+     */
+    const size_t SAMPLE_COUNT = 2;
+
+    /**
+     * @brief takes several timed samples of the same work and provides the fastest, which is the sample
+     * least disturbed by the rest of the system and so the most repeatable between runs
+     * @param sample the function to run for each sample, returning the time it measured
+     * @return the fastest sample time
+     */
+    template <typename Sample>
+    double fastest_sample(Sample sample)
+    {
+        double best = -1.0;
+
+        for (size_t i = 0; i < SAMPLE_COUNT; ++i)
+        {
+            const double value = sample();
+            if (best < 0.0 || value < best)
+            {
+                best = value;
+            }
+        }
+
+        return best;
+    }
+
+    /**
+     * @brief exposes the accumulated forces of a physics body so that they can be checked
+     */
+    class BenchBody : public PhysicsBody
+    {
+    public:
+        explicit BenchBody(RigidBodySet& body_set) :
+            PhysicsBody(body_set)
+        {
+            // Empty Constructor
+        }
+
+        double get_force_sum() const
+        {
+            return body_set->force_x[body_index] + body_set->force_y[body_index] + get_moment();
+        }
+    };
+
+    /**
+     * @brief provides fixed random inputs so that the kernels cannot be constant-folded
+     */
+    struct BenchInputs
+    {
+        explicit BenchInputs(const size_t count)
+        {
+            std::mt19937 rng(1234);
+            std::uniform_real_distribution<double> dist(-100.0, 100.0);
+
+            for (size_t i = 0; i < count; ++i)
+            {
+                vectors.push_back(Vector2(dist(rng), dist(rng)));
+                offsets.push_back(Vector2(dist(rng), dist(rng)));
+                angles.push_back(dist(rng) * 0.01);
+            }
+        }
+
+        std::vector<Vector2> vectors;
+        std::vector<Vector2> offsets;
+        std::vector<double> angles;
+    };
+
+    /**
+     * @brief runs the given kernel repeatedly and reports the best time per operation
+     * @param name the benchmark name to report
+     * @param ops_per_call the number of operations performed by each kernel call
+     * @param kernel the kernel to run, returning a value to sink
+     */
+    template <typename Kernel>
+    void run_benchmark(
+        const std::string& name,
+        const size_t ops_per_call,
+        Kernel kernel)
+    {
+        const size_t calls_per_sample = 2000;
+
+        // Run the kernel once first so that its caches are warm for every sample
+        result_sink = kernel();
+
+        const double best_ns = fastest_sample([&]() {
+            const auto start_time = std::chrono::steady_clock::now();
+
+            for (size_t i = 0; i < calls_per_sample; ++i)
+            {
+                result_sink = kernel();
+            }
+
+            const auto end_time = std::chrono::steady_clock::now();
+            return std::chrono::duration<double, std::nano>(end_time - start_time).count() / static_cast<double>(calls_per_sample * ops_per_call);
+        });
+
+        record_result(name, best_ns, "ns/op");
+    }
+
+    /**
+     * @brief provides a fixed collision shape
+     */
+    class BenchCollider : public Collider
+    {
+    public:
+        explicit BenchCollider(const CollisionShape& shape) :
+            shape(shape)
+        {
+            // Empty Constructor
+        }
+
+        virtual CollisionShape get_collision_shape() const override
+        {
+            return shape;
+        }
+
+    protected:
+        CollisionShape shape;
+    };
+
+    /**
+     * @brief reports the cost of finding all contacts in collision worlds of increasing size, with the
+     * bodies spread over an area that grows with the body count so that the density stays the same,
+     * which should cost close to the same time per body at every size
+     */
+    void run_collision_world_scaling()
+    {
+        for (const size_t body_count : { 64, 512, 4096, 32768 })
+        {
+            // Scatter weight-sized circles and gondola-sized boxes, about 1 body per 100x100 pixels
+            const double side = 100.0 * std::sqrt(static_cast<double>(body_count));
+
+            std::mt19937 rng(1234);
+            std::uniform_real_distribution<double> position(0.0, side);
+            std::uniform_real_distribution<double> angle(-1.0, 1.0);
+
+            RigidBodySet body_set;
+            std::vector<std::unique_ptr<BenchBody>> bodies;
+            std::vector<std::unique_ptr<BenchCollider>> colliders;
+            CollisionWorld world;
+
+            for (size_t i = 0; i < body_count; ++i)
+            {
+                const Vector2 center(position(rng), position(rng));
+                CollisionShape shape = CollisionShape::circle(center, 10.0);
+
+                if (i % 2 == 1)
+                {
+                    const double rotation = angle(rng);
+                    const Vector2 corners[4] = {
+                        center + Vector2(-20.0, -15.0).rotate_rad(rotation),
+                        center + Vector2(-20.0, 15.0).rotate_rad(rotation),
+                        center + Vector2(20.0, 15.0).rotate_rad(rotation),
+                        center + Vector2(20.0, -15.0).rotate_rad(rotation)
+                    };
+                    shape = CollisionShape::polygon(gio::Span<const Vector2>(corners));
+                }
+
+                bodies.push_back(std::make_unique<BenchBody>(body_set));
+                colliders.push_back(std::make_unique<BenchCollider>(shape));
+                world.add(bodies.back().get(), colliders.back().get());
+            }
+
+            // Time the best of several samples, each running enough updates to cover a similar number
+            // of bodies, so that the small worlds are not timed over only a few microseconds
+            const size_t updates_per_sample = std::max<size_t>(1, 262144 / body_count);
+
+            world.update();
+
+            const double best_ns = fastest_sample([&]() {
+                const auto start_time = std::chrono::steady_clock::now();
+
+                for (size_t i = 0; i < updates_per_sample; ++i)
+                {
+                    world.update();
+                }
+
+                const auto end_time = std::chrono::steady_clock::now();
+                return std::chrono::duration<double, std::nano>(end_time - start_time).count() / static_cast<double>(updates_per_sample * body_count);
+            });
+
+            if (bench_round == 0)
+            {
+                std::cout << "collision_world_" << body_count << ": "
+                    << static_cast<double>(world.get_pair_test_count()) / static_cast<double>(body_count) << " shape tests/body, "
+                    << world.get_contacts().size() << " contacts" << std::endl;
+            }
+            record_result("collision_world_update_" + std::to_string(body_count), best_ns, "ns/body");
+        }
+    }
+
+    /**
+     * @brief sets up a scenario, lets it settle and times a single sample of its substeps
+     * @return the time of each substep per balloon, in nanoseconds
+     */
+    template <typename Setup>
+    double time_scenario(
+        const size_t balloon_count,
+        const size_t warm_up_steps,
+        Setup& setup)
+    {
+        // Time a similar number of balloon substeps for every scene size, enough for several milliseconds
+        const size_t num_steps = std::max<size_t>(2000, 20000 / balloon_count);
+
+        Scene scene;
+        InputManager input_manager;
+
+        setup(scene, input_manager);
+
+        // The inputs are held for the whole scenario, with any rising edges seen by the first substep
+        InputSnapshot input_snapshot = input_manager.take_snapshot();
+
+        WorldState world_state;
+        world_state.input = &input_snapshot;
+        world_state.time_step = 0.0001;
+        world_state.gravity = Vector2(0.0, 10.0);
+        world_state.terrain = &scene.get_terrain();
+
+        for (size_t i = 0; i < warm_up_steps; ++i)
+        {
+            scene.pre_step(&world_state);
+            scene.step(&world_state);
+            scene.post_step(&world_state);
+
+            input_snapshot.clear_rising_edges();
+        }
+
+        const auto start_time = std::chrono::steady_clock::now();
+
+        for (size_t i = 0; i < num_steps; ++i)
+        {
+            scene.pre_step(&world_state);
+            scene.step(&world_state);
+            scene.post_step(&world_state);
+        }
+
+        const auto end_time = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::nano>(end_time - start_time).count() / static_cast<double>(num_steps * balloon_count);
+    }
+
+    /**
+     * @brief steps a scenario set up on a scene over the default terrain, first letting it settle into
+     * the state being measured and then reporting the cost of each substep per balloon. Every scenario
+     * uses fixed inputs and positions, so that each run simulates exactly the same flight. Each sample
+     * sets the scenario up again from the start, and the fastest sample is reported
+     * @param name the scenario name
+     * @param balloon_count the number of balloons created by the setup, used to scale the result
+     * @param warm_up_steps the number of substeps to run before timing
+     * @param setup the function to create the scenario, given the scene and the input manager
+     */
+    template <typename Setup>
+    void run_scenario(
+        const std::string& name,
+        const size_t balloon_count,
+        const size_t warm_up_steps,
+        Setup setup)
+    {
+        const double ns = fastest_sample([&]() {
+            return time_scenario(balloon_count, warm_up_steps, setup);
+        });
+
+        record_result("scenario_" + name, ns, "ns/balloon-substep");
+    }
+
+    /**
+     * @brief reports the cost of stepping a balloon in each of the reproducible flight scenarios, and of
+     * scenes of increasing numbers of balloons, which should cost close to the same time per balloon
+     */
+    void run_balloon_scenarios()
+    {
+        const Vector2 START_POSITION(640.0, 360.0);
+        const double BALLOON_SPACING = 300.0;
+
+        // A balloon left alone near its equilibrium height, far above the terrain
+        run_scenario("idle_hover", 1, 0, [&](Scene& scene, InputManager&) {
+            scene.create_balloon(START_POSITION);
+        });
+
+        // A cooling balloon pushed to the right, so that it settles onto the terrain and drags its
+        // gondola and weights along the ground, running the full contact test for every body
+        run_scenario("ground_drag", 1, 60000, [&](Scene& scene, InputManager& input_manager) {
+            const double ground = scene.get_terrain().elevation_at_x(START_POSITION.x);
+            scene.create_balloon(Vector2(START_POSITION.x, ground - 60.0));
+
+            input_manager.set_key_down(ALLEGRO_KEY_DOWN);
+            input_manager.set_key_down(ALLEGRO_KEY_RIGHT);
+        });
+
+        // A balloon that has cut both weights loose, timed while the weights are still falling
+        run_scenario("broken_ropes", 1, 1000, [&](Scene& scene, InputManager& input_manager) {
+            scene.create_balloon(START_POSITION);
+
+            input_manager.set_key_down(ALLEGRO_KEY_1);
+            input_manager.set_key_down(ALLEGRO_KEY_2);
+        });
+
+        // Scenes of climbing balloons, spread out so that they do not touch
+        for (const size_t balloon_count : { 1, 10, 100 })
+        {
+            run_scenario("scene_" + std::to_string(balloon_count) + "_balloons", balloon_count, 0, [&](Scene& scene, InputManager& input_manager) {
+                scene.reserve(balloon_count, 0, 0);
+                for (size_t i = 0; i < balloon_count; ++i)
+                {
+                    scene.create_balloon(START_POSITION + Vector2(BALLOON_SPACING * static_cast<double>(i), 0.0));
+                }
+
+                input_manager.set_key_down(ALLEGRO_KEY_UP);
+            });
+        }
+    }
+
+    /**
+     * @brief a stream buffer that discards everything written to it without allocating, for recording
+     * input during the allocation check
+     */
+    class DiscardBuffer : public std::streambuf
+    {
+    protected:
+        virtual int_type overflow(int_type c) override
+        {
+            return traits_type::not_eof(c);
+        }
+    };
+
+    /**
+     * @brief runs the physics ticks of GameState::step through the same PhysicsStepper for each
+     * integrator and rope mode on a scene of two balloons with a loose weight roped to the first, and
+     * counts the heap allocations made once the scene has warmed up. The ticks forward key events,
+     * switch between the autopilot and player input, record the input and state hashes, time every
+     * other tick as the performance overlay does and publish a snapshot, which should never allocate
+     * @return true if no allocations were made after the warm-up for any of the settings
+     */
+    bool check_step_allocations()
+    {
+        const double PHYSICS_PERIOD = 1.0 / 30.0;
+        const double TIME_STEP = 0.0001;
+        const size_t WARM_UP_TICKS = 30;
+        const size_t CHECKED_TICKS = 60;
+        const size_t AUTOPILOT_SWITCH_TICKS = 10;
+
+        const IntegratorType integrators[] = {
+            IntegratorType::SEMI_IMPLICIT_EULER,
+            IntegratorType::VELOCITY_VERLET,
+            IntegratorType::RK4,
+            IntegratorType::ADAPTIVE
+        };
+
+        bool passed = true;
+
+        for (const IntegratorType integrator : integrators)
+        {
+            for (const RopeMode rope_mode : { RopeMode::SPRING, RopeMode::CONSTRAINT })
+            {
+                Scene scene;
+                TripleBuffer<BalloonSnapshot> snapshots;
+
+                scene.reserve(2, 1, 1);
+                Balloon& balloon = *scene.create_balloon(Vector2(640.0, 360.0));
+                scene.create_balloon(Vector2(940.0, 360.0));
+
+                SceneWeight& weight = *scene.create_weight(Vector2(640.0, 480.0));
+                scene.create_rope(
+                    &balloon.get_gondola(),
+                    balloon.get_gondola().get_position(),
+                    &weight.weight,
+                    weight.weight.get_position());
+
+                WorldState world_state;
+                world_state.time_step = TIME_STEP;
+                world_state.gravity = Vector2(0.0, 10.0);
+                world_state.integrator = integrator;
+                world_state.rope_mode = rope_mode;
+                world_state.terrain = &scene.get_terrain();
+
+                PhysicsStepper physics(scene, balloon, world_state);
+
+                DiscardBuffer discard_buffer;
+                std::ostream recording(&discard_buffer);
+                InputRecorder recorder(
+                    recording,
+                    flight_recording_keys(),
+                    encode_flight_metadata(world_state, scene.get_terrain().get_settings(), balloon.get_gondola().get_position()));
+                physics.set_recorder(&recorder);
+
+                const size_t num_steps = static_cast<size_t>(PHYSICS_PERIOD / TIME_STEP);
+                size_t start_count = 0;
+
+                for (size_t tick = 0; tick < WARM_UP_TICKS + CHECKED_TICKS; ++tick)
+                {
+                    if (tick == WARM_UP_TICKS)
+                    {
+                        start_count = allocation_count.load(std::memory_order_relaxed);
+                    }
+
+                    // Tap the burner key, and hand the balloon between the autopilot and the player
+                    physics.queue_key_event(ALLEGRO_KEY_UP, tick % 2 == 0);
+                    physics.set_autopilot_enabled((tick / AUTOPILOT_SWITCH_TICKS) % 2 == 0);
+
+                    physics.tick(num_steps, tick % 2 == 0);
+
+                    balloon.write_snapshot(snapshots.write_buffer());
+                    snapshots.publish();
+                }
+
+                const size_t allocations = allocation_count.load(std::memory_order_relaxed) - start_count;
+
+                std::cout << "step_allocations_" << integrator_name(integrator) << "_"
+                    << (rope_mode == RopeMode::SPRING ? "spring" : "constraint") << ": "
+                    << allocations << " allocations in " << CHECKED_TICKS << " ticks" << std::endl;
+
+                if (allocations > 0)
+                {
+                    passed = false;
+                }
+            }
+        }
+
+        return passed;
+    }
+
+    /**
+     * @brief the result of simulating the integrator scenario
+     */
+    struct ScenarioResult
+    {
+        std::vector<Vector2> trajectory;
+        double wall_seconds = 0.0;
+    };
+
+    /**
+     * @brief simulates the balloon with scripted inputs, climbing with the burner on and then
+     * drifting back down onto the terrain, recording the gondola position at each game tick
+     * @param integrator the integrator to use
+     * @param steps_per_tick the number of physics steps per 1/30 s game tick
+     * @param tolerance the adaptive integrator tolerance
+     * @param rope_mode the rope mode to use
+     * @return the recorded trajectory and run time
+     */
+    ScenarioResult run_integrator_scenario(
+        const IntegratorType integrator,
+        const size_t steps_per_tick,
+        const double tolerance,
+        const RopeMode rope_mode)
+    {
+        const double TICK_PERIOD = 1.0 / 30.0;
+        const size_t NUM_TICKS = 30 * 12;
+
+        Terrain terrain;
+        Balloon balloon;
+        InputManager input_manager;
+
+        balloon.set_position(640.0, 360.0);
+
+        InputSnapshot input_snapshot;
+
+        WorldState world_state;
+        world_state.input = &input_snapshot;
+        world_state.time_step = TICK_PERIOD / static_cast<double>(steps_per_tick);
+        world_state.gravity = Vector2(0.0, 10.0);
+        world_state.terrain = &terrain;
+        world_state.integrator = integrator;
+        world_state.adaptive_tolerance = tolerance;
+        world_state.rope_mode = rope_mode;
+
+        ScenarioResult result;
+        result.trajectory.reserve(NUM_TICKS);
+
+        const auto start_time = std::chrono::steady_clock::now();
+
+        for (size_t tick = 0; tick < NUM_TICKS; ++tick)
+        {
+            // Burn for the first 6 s while pushing right for part of it, then let the balloon settle
+            if (tick == 0)
+            {
+                input_manager.set_key_down(ALLEGRO_KEY_UP);
+            }
+            else if (tick == 30 * 2)
+            {
+                input_manager.set_key_down(ALLEGRO_KEY_RIGHT);
+            }
+            else if (tick == 30 * 4)
+            {
+                input_manager.set_key_up(ALLEGRO_KEY_RIGHT);
+            }
+            else if (tick == 30 * 6)
+            {
+                input_manager.set_key_up(ALLEGRO_KEY_UP);
+            }
+
+            input_snapshot = input_manager.take_snapshot();
+
+            for (size_t i = 0; i < steps_per_tick; ++i)
+            {
+                balloon.pre_step(&world_state);
+                balloon.step(&world_state);
+                balloon.post_step(&world_state);
+
+                input_snapshot.clear_rising_edges();
+            }
+
+            result.trajectory.push_back(balloon.get_gondola().get_position());
+        }
+
+        const auto end_time = std::chrono::steady_clock::now();
+        result.wall_seconds = std::chrono::duration<double>(end_time - start_time).count();
+
+        return result;
+    }
+
+    /**
+     * @brief reports the CPU time per simulated second and the trajectory error against a fine RK4
+     * reference for each integrator and rope mode over a range of time steps
+     */
+    void run_integrator_comparison()
+    {
+        struct Config
+        {
+            IntegratorType integrator;
+            size_t steps_per_tick;
+            double tolerance;
+            RopeMode rope_mode;
+        };
+
+        const Config configs[] = {
+            { IntegratorType::SEMI_IMPLICIT_EULER, 333, 0.0, RopeMode::SPRING },
+            { IntegratorType::SEMI_IMPLICIT_EULER, 33, 0.0, RopeMode::SPRING },
+            { IntegratorType::SEMI_IMPLICIT_EULER, 8, 0.0, RopeMode::SPRING },
+            { IntegratorType::VELOCITY_VERLET, 33, 0.0, RopeMode::SPRING },
+            { IntegratorType::VELOCITY_VERLET, 8, 0.0, RopeMode::SPRING },
+            { IntegratorType::VELOCITY_VERLET, 4, 0.0, RopeMode::SPRING },
+            { IntegratorType::RK4, 33, 0.0, RopeMode::SPRING },
+            { IntegratorType::RK4, 8, 0.0, RopeMode::SPRING },
+            { IntegratorType::RK4, 4, 0.0, RopeMode::SPRING },
+            { IntegratorType::ADAPTIVE, 8, 1e-3, RopeMode::SPRING },
+            { IntegratorType::ADAPTIVE, 8, 1e-4, RopeMode::SPRING },
+            { IntegratorType::ADAPTIVE, 1, 1e-4, RopeMode::SPRING },
+            { IntegratorType::SEMI_IMPLICIT_EULER, 33, 0.0, RopeMode::CONSTRAINT },
+            { IntegratorType::SEMI_IMPLICIT_EULER, 8, 0.0, RopeMode::CONSTRAINT },
+            { IntegratorType::SEMI_IMPLICIT_EULER, 2, 0.0, RopeMode::CONSTRAINT },
+            { IntegratorType::VELOCITY_VERLET, 8, 0.0, RopeMode::CONSTRAINT },
+            { IntegratorType::RK4, 8, 0.0, RopeMode::CONSTRAINT },
+            { IntegratorType::RK4, 2, 0.0, RopeMode::CONSTRAINT },
+        };
+
+        // The errors are only printed in the first round, so the slow fine references are only run then
+        ScenarioResult spring_reference;
+        ScenarioResult constraint_reference;
+
+        if (bench_round == 0)
+        {
+            spring_reference = run_integrator_scenario(IntegratorType::RK4, 3333, 0.0, RopeMode::SPRING);
+            constraint_reference = run_integrator_scenario(IntegratorType::RK4, 3333, 0.0, RopeMode::CONSTRAINT);
+        }
+
+        for (const Config& config : configs)
+        {
+            // Every run follows the same trajectory, so keep the first and time the fastest
+            ScenarioResult result = run_integrator_scenario(config.integrator, config.steps_per_tick, config.tolerance, config.rope_mode);
+            result.wall_seconds = std::min(result.wall_seconds, fastest_sample([&]() {
+                return run_integrator_scenario(config.integrator, config.steps_per_tick, config.tolerance, config.rope_mode).wall_seconds;
+            }));
+
+            const double sim_seconds = static_cast<double>(result.trajectory.size()) / 30.0;
+
+            std::string result_name = std::string("integrator_") + integrator_name(config.integrator)
+                + ((config.rope_mode == RopeMode::CONSTRAINT) ? "_constraint" : "")
+                + "_" + std::to_string(config.steps_per_tick) + "_steps";
+            if (config.integrator == IntegratorType::ADAPTIVE)
+            {
+                result_name += "_tol_" + std::to_string(static_cast<int>(std::round(-std::log10(config.tolerance))));
+            }
+            record_result(result_name, 1000.0 * result.wall_seconds / sim_seconds, "ms/sim-s");
+
+            if (bench_round != 0)
+            {
+                continue;
+            }
+
+            const ScenarioResult& reference = (config.rope_mode == RopeMode::CONSTRAINT) ? constraint_reference : spring_reference;
+
+            double max_error = 0.0;
+            for (size_t i = 0; i < result.trajectory.size(); ++i)
+            {
+                const double error = result.trajectory[i].distance_to(reference.trajectory[i]);
+                if (!std::isfinite(error))
+                {
+                    max_error = error;
+                    break;
+                }
+
+                max_error = std::max(max_error, error);
+            }
+
+            std::cout << result_name << " (dt=" << 1.0 / 30.0 / static_cast<double>(config.steps_per_tick);
+            if (config.integrator == IntegratorType::ADAPTIVE)
+            {
+                std::cout << " tol=" << config.tolerance;
+            }
+            std::cout << "): ";
+
+            if (std::isfinite(max_error))
+            {
+                std::cout << "max gondola error " << max_error << std::endl;
+            }
+            else
+            {
+                std::cout << "unstable" << std::endl;
+            }
+        }
+    }
+
+    /**
+     * @brief writes every result to a JSON file
+     * @param path the file to write
+     * @return true if the file was written
+     */
+    bool write_results(const std::string& path)
+    {
+        std::ofstream file(path);
+        if (!file)
+        {
+            return false;
+        }
+
+        file.precision(9);
+        file << "{\n  \"results\": [\n";
+
+        for (size_t i = 0; i < bench_results.size(); ++i)
+        {
+            const BenchResult& result = bench_results[i];
+            file << "    { \"name\": \"" << result.name << "\", \"value\": " << result.value << ", \"unit\": \"" << result.unit << "\" }"
+                << ((i + 1 < bench_results.size()) ? "," : "") << "\n";
+        }
+
+        file << "  ]\n}\n";
+        return static_cast<bool>(file);
+    }
+
+    /**
+     * @brief reads the results from a JSON file written by write_results, reading each name and value
+     * pair in order without checking the rest of the structure
+     * @param path the file to read
+     * @param results set to the results read
+     * @return true if the file could be read
+     */
+    bool read_results(
+        const std::string& path,
+        std::vector<BenchResult>& results)
+    {
+        std::ifstream file(path);
+        if (!file)
+        {
+            return false;
+        }
+
+        const std::string text((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        const std::string NAME_KEY = "\"name\"";
+        const std::string VALUE_KEY = "\"value\"";
+
+        results.clear();
+
+        for (size_t pos = text.find(NAME_KEY); pos != std::string::npos; pos = text.find(NAME_KEY, pos))
+        {
+            // Read the quoted name following the key
+            const size_t name_start = text.find('"', text.find(':', pos + NAME_KEY.size()));
+            const size_t name_end = text.find('"', name_start + 1);
+            const size_t value_pos = text.find(VALUE_KEY, name_end);
+
+            if (name_start == std::string::npos || name_end == std::string::npos || value_pos == std::string::npos)
+            {
+                return false;
+            }
+
+            // Read the number following the value key
+            const size_t number_start = text.find(':', value_pos + VALUE_KEY.size()) + 1;
+            char* number_end = nullptr;
+            const double value = std::strtod(text.c_str() + number_start, &number_end);
+
+            if (number_end == text.c_str() + number_start)
+            {
+                return false;
+            }
+
+            results.push_back({ text.substr(name_start + 1, name_end - name_start - 1), value, std::string() });
+            pos = static_cast<size_t>(number_end - text.c_str());
+        }
+
+        return true;
+    }
+
+    /**
+     * @brief compares every result with the matching baseline result, listing each change and flagging
+     * any result that has become slower than the baseline by more than the threshold. A baseline result
+     * missing from this run is flagged too, so that a renamed or removed benchmark cannot pass unseen
+     * @param baseline the baseline results
+     * @param threshold the allowed increase, as a fraction of the baseline value
+     * @return the number of regressions and missing results found
+     */
+    size_t compare_results(
+        const std::vector<BenchResult>& baseline,
+        const double threshold)
+    {
+        size_t regression_count = 0;
+        size_t new_count = 0;
+        size_t missing_count = 0;
+
+        std::cout << std::endl << "comparison with baseline, flagging increases over " << 100.0 * threshold << "%:" << std::endl;
+
+        for (const BenchResult& result : bench_results)
+        {
+            const auto match = std::find_if(baseline.begin(), baseline.end(), [&result](const BenchResult& base) { return base.name == result.name; });
+
+            std::cout << "  " << result.name << ": ";
+
+            if (match == baseline.end())
+            {
+                std::cout << result.value << " " << result.unit << " (new, not in baseline)" << std::endl;
+                ++new_count;
+                continue;
+            }
+
+            if (match->value <= 0.0)
+            {
+                std::cout << result.value << " " << result.unit << " (no baseline value)" << std::endl;
+                continue;
+            }
+
+            const double change = (result.value - match->value) / match->value;
+            std::cout << match->value << " -> " << result.value << " " << result.unit << " (" << (change >= 0.0 ? "+" : "") << 100.0 * change << "%)";
+
+            if (change > threshold)
+            {
+                std::cout << " REGRESSION";
+                ++regression_count;
+            }
+
+            std::cout << std::endl;
+        }
+
+        // List the baseline results that this run no longer produces
+        for (const BenchResult& base : baseline)
+        {
+            const auto match = std::find_if(bench_results.begin(), bench_results.end(), [&base](const BenchResult& result) { return result.name == base.name; });
+
+            if (match == bench_results.end())
+            {
+                std::cout << "  " << base.name << ": " << base.value << " -> not run MISSING" << std::endl;
+                ++missing_count;
+            }
+        }
+
+        std::cout << regression_count << " regressions, " << missing_count << " missing, " << new_count << " new" << std::endl;
+        return regression_count + missing_count;
+    }
+
+    /**
+     * @brief runs a single round of every check and benchmark, keeping the results
+     * @return false if a check failed
+     */
+    bool run_benchmarks()
+    {
+        const BenchInputs inputs(1024);
+        const size_t count = inputs.vectors.size();
+
+        run_benchmark("vector2_rotate_rad", count, [&]() {
+            Vector2 sum;
+            for (size_t i = 0; i < count; ++i)
+            {
+                sum += inputs.vectors[i].rotate_rad(inputs.angles[i]);
+            }
+            return sum.x + sum.y;
+        });
+
+        run_benchmark("vector2_rotate_rad_sincos", count, [&]() {
+            const SinCos angle(inputs.angles[0]);
+            Vector2 sum;
+            for (size_t i = 0; i < count; ++i)
+            {
+                sum += inputs.vectors[i].rotate_rad(angle);
+            }
+            return sum.x + sum.y;
+        });
+
+        run_benchmark("vector2_normalize", count, [&]() {
+            Vector2 sum;
+            for (size_t i = 0; i < count; ++i)
+            {
+                sum += inputs.vectors[i].normalize();
+            }
+            return sum.x + sum.y;
+        });
+
+        run_benchmark("vector2_dot_cross", count, [&]() {
+            double sum = 0.0;
+            for (size_t i = 0; i < count; ++i)
+            {
+                sum += inputs.vectors[i].dot(inputs.offsets[i]) + inputs.vectors[i].cross(inputs.offsets[i]);
+            }
+            return sum;
+        });
+
+        run_benchmark("physics_add_force_absolute", count, [&]() {
+            RigidBodySet body_set;
+            BenchBody body(body_set);
+            for (size_t i = 0; i < count; ++i)
+            {
+                body.add_force_absolute(inputs.vectors[i], inputs.offsets[i]);
+            }
+            return body.get_force_sum();
+        });
+
+        run_benchmark("physics_add_force_relative", count, [&]() {
+            RigidBodySet body_set;
+            BenchBody body(body_set);
+            for (size_t i = 0; i < count; ++i)
+            {
+                body.add_force_relative(inputs.vectors[i], inputs.offsets[i]);
+            }
+            return body.get_force_sum();
+        });
+
+        RigidBodySet body_set;
+        for (size_t i = 0; i < 512; ++i)
+        {
+            const size_t index = body_set.add_body();
+            body_set.velocity_x[index] = inputs.vectors[i].x;
+            body_set.velocity_y[index] = inputs.vectors[i].y;
+            body_set.force_x[index] = inputs.offsets[i].x;
+            body_set.force_y[index] = inputs.offsets[i].y;
+            body_set.moment[index] = inputs.angles[i];
+        }
+
+        PhysicsState physics_state;
+        physics_state.time_step = 0.0001;
+        physics_state.gravity = Vector2(0.0, 10.0);
+
+        // Check that the strict vector kernel matches the scalar reference bit for bit
+        RigidBodySet scalar_set = body_set;
+        RigidBodySet vector_set = body_set;
+        for (size_t i = 0; i < 1000; ++i)
+        {
+            gio::integrate_bodies_scalar(scalar_set, physics_state);
+            gio::integrate_bodies(vector_set, physics_state);
+        }
+
+        const std::vector<double>* scalar_fields[] = { &scalar_set.position_x, &scalar_set.position_y, &scalar_set.velocity_x, &scalar_set.velocity_y, &scalar_set.rotation, &scalar_set.rotational_vel };
+        const std::vector<double>* vector_fields[] = { &vector_set.position_x, &vector_set.position_y, &vector_set.velocity_x, &vector_set.velocity_y, &vector_set.rotation, &vector_set.rotational_vel };
+
+        for (size_t i = 0; i < sizeof(scalar_fields) / sizeof(scalar_fields[0]); ++i)
+        {
+            if (std::memcmp(scalar_fields[i]->data(), vector_fields[i]->data(), scalar_fields[i]->size() * sizeof(double)) != 0)
+            {
+                std::cerr << "strict " << gio::integrator_kernel_isa() << " integration does not match the scalar path" << std::endl;
+                return false;
+            }
+        }
+
+        // Check that the game step path does not allocate once running, which only needs to be done once
+        if (bench_round == 0)
+        {
+            std::cout << "integrator kernel: " << gio::integrator_kernel_isa() << " (strict mode matches scalar)" << std::endl;
+        }
+
+        if (bench_round == 0 && !check_step_allocations())
+        {
+            std::cerr << "the step path allocated after warming up" << std::endl;
+            return false;
+        }
+
+        run_benchmark("rigid_body_set_integrate_scalar", body_set.size(), [&]() {
+            gio::integrate_bodies_scalar(body_set, physics_state);
+            return body_set.position_x[0] + body_set.rotation[0];
+        });
+
+        run_benchmark("rigid_body_set_integrate_strict", body_set.size(), [&]() {
+            body_set.integrate(physics_state);
+            return body_set.position_x[0] + body_set.rotation[0];
+        });
+
+        physics_state.strict_integration = false;
+
+        run_benchmark("rigid_body_set_integrate_fast", body_set.size(), [&]() {
+            body_set.integrate(physics_state);
+            return body_set.position_x[0] + body_set.rotation[0];
+        });
+
+        // Step slack rope chains of different lengths to check that the cost per segment stays flat
+        WorldState chain_state;
+        chain_state.time_step = 1.0 / 240.0;
+        chain_state.gravity = Vector2(0.0, 10.0);
+
+        RigidBodySet chain_bodies;
+        PhysicsBody chain_anchor_a(chain_bodies);
+        PhysicsBody chain_anchor_b(chain_bodies);
+
+        for (const size_t segment_count : { 16, 128, 1024 })
+        {
+            RopeChain chain(100.0, segment_count);
+            chain.set_object_a(&chain_anchor_a);
+            chain.set_object_b(&chain_anchor_b);
+            chain.set_point_a(Vector2(0.0, 0.0));
+            chain.set_point_b(Vector2(100.0, 0.0));
+            chain.apply_forces(&chain_state);
+            chain.set_point_b(Vector2(60.0, 0.0));
+
+            run_benchmark("rope_chain_step_" + std::to_string(segment_count), segment_count, [&]() {
+                chain.post_step(&chain_state);
+                chain.update_particles();
+                return chain.get_particle(segment_count / 2).y;
+            });
+        }
+
+        // Apply the force of a stretched spring rope, which each balloon rope does every substep
+        Rope spring_rope(100.0);
+        spring_rope.set_object_a(&chain_anchor_a);
+        spring_rope.set_object_b(&chain_anchor_b);
+        spring_rope.set_point_a(Vector2(0.0, 0.0));
+        spring_rope.set_point_b(Vector2(100.0, 10.0));
+        spring_rope.set_init_length(90.0);
+
+        run_benchmark("rope_apply_forces", count, [&]() {
+            for (size_t i = 0; i < count; ++i)
+            {
+                spring_rope.apply_forces(&chain_state);
+            }
+            return chain_anchor_a.get_velocity().x;
+        });
+
+        // Look up the terrain under five nearby contact points, as the gondola corners and a weight do
+        // each substep, comparing the cached height field with the direct noise and the original sine
+        std::vector<double> contact_xs;
+        for (size_t i = 0; i < count; ++i)
+        {
+            contact_xs.push_back(640.0 + 0.5 * static_cast<double>(i) + static_cast<double>(i % 5) * 8.0);
+        }
+
+        Terrain terrain;
+        TerrainGenerator terrain_generator(terrain.get_settings());
+
+        run_benchmark("terrain_sine_reference", count, [&]() {
+            double sum = 0.0;
+            for (size_t i = 0; i < count; ++i)
+            {
+                sum += 650.0 + 20.0 * std::sin(0.01 * contact_xs[i]);
+            }
+            return sum;
+        });
+
+        run_benchmark("terrain_generator_" + std::to_string(terrain.get_settings().octaves) + "_octaves", count, [&]() {
+            double sum = 0.0;
+            for (size_t i = 0; i < count; ++i)
+            {
+                sum += terrain_generator.elevation_at_x(contact_xs[i]);
+            }
+            return sum;
+        });
+
+        run_benchmark("terrain_elevation_at_x", count, [&]() {
+            double sum = 0.0;
+            for (size_t i = 0; i < count; ++i)
+            {
+                sum += terrain.elevation_at_x(contact_xs[i]);
+            }
+            return sum;
+        });
+
+        run_benchmark("terrain_surface_normal_at_x", count, [&]() {
+            Vector2 sum;
+            for (size_t i = 0; i < count; ++i)
+            {
+                sum += terrain.surface_normal_at_x(contact_xs[i]);
+            }
+            return sum.x + sum.y;
+        });
+
+        std::vector<double> sampled_heights(count);
+        std::vector<Vector2> sampled_normals(count);
+
+        run_benchmark("terrain_sample_heights", count, [&]() {
+            terrain.sample(contact_xs, sampled_heights, gio::Span<Vector2>());
+            return sampled_heights[count / 2];
+        });
+
+        run_benchmark("terrain_sample_heights_normals", count, [&]() {
+            terrain.sample(contact_xs, sampled_heights, sampled_normals);
+            return sampled_heights[count / 2] + sampled_normals[count / 2].x;
+        });
+
+        run_benchmark("terrain_highest_point_between", count, [&]() {
+            double sum = 0.0;
+            for (size_t i = 0; i < count; ++i)
+            {
+                sum += terrain.highest_point_between(contact_xs[i] - 25.0, contact_xs[i] + 25.0);
+            }
+            return sum;
+        });
+
+        run_collision_world_scaling();
+
+        run_balloon_scenarios();
+
+        run_integrator_comparison();
+
+        return true;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    // Parse the command line options
+    const char* json_path = nullptr;
+    const char* baseline_path = nullptr;
+    double threshold = 0.10;
+    size_t rounds = 10;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "--json") == 0 && i + 1 < argc)
+        {
+            json_path = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--compare") == 0 && i + 1 < argc)
+        {
+            baseline_path = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--threshold") == 0 && i + 1 < argc && std::atof(argv[i + 1]) >= 0.0)
+        {
+            threshold = std::atof(argv[++i]) / 100.0;
+        }
+        else if (std::strcmp(argv[i], "--rounds") == 0 && i + 1 < argc && std::atoi(argv[i + 1]) > 0)
+        {
+            rounds = static_cast<size_t>(std::atoi(argv[++i]));
+        }
+        else
+        {
+            std::cerr << "usage: " << argv[0] << " [--json FILE] [--compare BASELINE] [--threshold PERCENT] [--rounds N]" << std::endl;
+            return 1;
+        }
+    }
+
+    // Read the baseline first, so that a bad path fails before running every benchmark
+    std::vector<BenchResult> baseline;
+    if (baseline_path != nullptr && !read_results(baseline_path, baseline))
+    {
+        std::cerr << "unable to read baseline results from " << baseline_path << std::endl;
+        return 1;
+    }
+
+    // Run every benchmark in several rounds spread over the whole run, keeping the fastest result of
+    // each, so that a few seconds of load from elsewhere on the system do not skew any single result
+    for (bench_round = 0; bench_round < rounds; ++bench_round)
+    {
+        if (!run_benchmarks())
+        {
+            return 1;
+        }
+    }
+
+    std::cout << std::endl << "fastest of " << rounds << " rounds:" << std::endl;
+    for (const BenchResult& result : bench_results)
+    {
+        std::cout << result.name << ": " << result.value << " " << result.unit << std::endl;
+    }
+
+    if (json_path != nullptr && !write_results(json_path))
+    {
+        std::cerr << "unable to write results to " << json_path << std::endl;
+        return 1;
+    }
+
+    // Fail if any result is slower than the baseline by more than the threshold, or is missing
+    if (baseline_path != nullptr && compare_results(baseline, threshold) > 0)
+    {
+        return 1;
+    }
+
+    return 0;
+}
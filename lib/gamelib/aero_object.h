@@ -3,26 +3,60 @@
 
 #include <gamelib/physics_object.h>
 
+#include <cmath>
+
 /**
  * @brief Provides basic aerodynamics forces for a physics object
+ * @tparam StateType the step state type, which must provide the physics state parameters
  */
-class AeroObject : public PhysicsObject
+template <typename StateType>
+class AeroObject : public PhysicsObject<StateType>
 {
 public:
     /**
      * @brief construcst the aerodynamics object
+     * @param body_set the rigid body set to store the body state in
      * @param cd_translation the translational drag coefficient to use
      * @param cd_rotation the rotational drag coefficient to use
      */
     AeroObject(
+        RigidBodySet& body_set,
         const double cd_translation,
-        const double cd_rotation);
+        const double cd_rotation) :
+        PhysicsObject<StateType>(body_set),
+        cd_translation(cd_translation),
+        cd_rotation(cd_rotation)
+    {
+        // Empty Constructor
+    }
 
     /**
-     * @brief state to run before the physics step to setup the aerodynamics forces
+     * @brief applies the aerodynamics forces for the current body state
      * @param state the step state to use for computation
     */
-    virtual void pre_step(const StepState* state) override;
+    virtual void apply_forces(const StateType* state) override
+    {
+        // Run the super force application
+        PhysicsObject<StateType>::apply_forces(state);
+
+        // Get the aerodynamic velocity squared
+        const Vector2 velocity = this->get_velocity();
+        const double vm2 = velocity.magnitude_squared();
+
+        // Apply drag in the opposite direction if the magnitude is great enough
+        if (std::abs(vm2) > 1e-6)
+        {
+            const Vector2 drag = -0.5 * cd_translation * vm2 * velocity.normalize();
+            this->add_force_absolute(drag);
+        }
+
+        // Apply rotational drag
+        const double rotational_vel = this->get_rotational_velocity();
+        if (std::abs(rotational_vel) > 1e-6)
+        {
+            this->add_moment(-0.5 * rotational_vel * std::abs(rotational_vel) * cd_rotation);
+        }
+    }
 
 protected:
     double cd_translation;
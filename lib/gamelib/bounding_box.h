@@ -0,0 +1,80 @@
+#ifndef GIO_BOUNDING_BOX_H
+#define GIO_BOUNDING_BOX_H
+
+#include <gamelib/vector2.h>
+
+#include <algorithm>
+
+/**
+ * @brief An axis-aligned bounding box, used to rule out contacts cheaply before any exact test
+ */
+struct BoundingBox
+{
+    /**
+     * @brief constructs an empty box at the origin
+     */
+    constexpr BoundingBox() :
+        min(),
+        max()
+    {
+        // Empty Constructor
+    }
+
+    /**
+     * @brief constructs a box with the given corners
+     * @param min the corner with the smallest coordinates
+     * @param max the corner with the largest coordinates
+     */
+    constexpr BoundingBox(
+        const Vector2& min,
+        const Vector2& max) :
+        min(min),
+        max(max)
+    {
+        // Empty Constructor
+    }
+
+    /**
+     * @brief constructs the box around a circle
+     * @param center the circle center
+     * @param radius the circle radius
+     * @return the bounding box
+     */
+    static constexpr BoundingBox around_circle(
+        const Vector2& center,
+        const double radius)
+    {
+        return BoundingBox(
+            Vector2(center.x - radius, center.y - radius),
+            Vector2(center.x + radius, center.y + radius));
+    }
+
+    /**
+     * @brief grows the box to include the given point
+     * @param point the point to include
+     */
+    void expand(const Vector2& point)
+    {
+        min.x = std::min(min.x, point.x);
+        min.y = std::min(min.y, point.y);
+        max.x = std::max(max.x, point.x);
+        max.y = std::max(max.y, point.y);
+    }
+
+    /**
+     * @brief determines if the box overlaps another box, including touching edges
+     * @param other the other box
+     * @return true if the boxes overlap
+     */
+    constexpr bool overlaps(const BoundingBox& other) const
+    {
+        return
+            min.x <= other.max.x && other.min.x <= max.x &&
+            min.y <= other.max.y && other.min.y <= max.y;
+    }
+
+    Vector2 min;
+    Vector2 max;
+};
+
+#endif // GIO_BOUNDING_BOX_H
@@ -0,0 +1,738 @@
+#include <gamelib/collision.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    /**
+     * @brief the number of surface sample points requested from the height field in each batch
+     */
+    const size_t SURFACE_BATCH = 32;
+
+    /**
+     * @brief the number of candidate contacts kept before reducing them to a manifold
+     */
+    const size_t MAX_CANDIDATES = 32;
+
+    /**
+     * @brief the amount the separation along an edge of the second polygon must exceed the separation along
+     * an edge of the first polygon by before the second polygon provides the reference edge
+     */
+    const double REFERENCE_TOLERANCE = 1e-3;
+
+    /**
+     * @brief Collects candidate contacts and reduces them to a manifold, keeping the deepest candidate
+     * and the candidate furthest from it. Once full, a new candidate replaces the shallowest one
+     */
+    class ContactReducer
+    {
+    public:
+        ContactReducer() :
+            count(0)
+        {
+            // Empty Constructor
+        }
+
+        void add(
+            const Vector2& point,
+            const Vector2& normal,
+            const double penetration)
+        {
+            size_t index = count;
+
+            if (count < MAX_CANDIDATES)
+            {
+                ++count;
+            }
+            else
+            {
+                index = 0;
+                for (size_t i = 1; i < count; ++i)
+                {
+                    if (candidates[i].penetration < candidates[index].penetration)
+                    {
+                        index = i;
+                    }
+                }
+
+                if (candidates[index].penetration >= penetration)
+                {
+                    return;
+                }
+            }
+
+            candidates[index].point = point;
+            candidates[index].normal = normal;
+            candidates[index].penetration = penetration;
+        }
+
+        void finish(ContactManifold& manifold) const
+        {
+            manifold.count = 0;
+            if (count == 0)
+            {
+                return;
+            }
+
+            // Keep the deepest candidate
+            size_t deepest = 0;
+            for (size_t i = 1; i < count; ++i)
+            {
+                if (candidates[i].penetration > candidates[deepest].penetration)
+                {
+                    deepest = i;
+                }
+            }
+
+            manifold.points[manifold.count++] = candidates[deepest];
+
+            // Keep the candidate furthest from the deepest, which spans the contact region
+            size_t furthest = deepest;
+            double furthest_distance = 0.0;
+
+            for (size_t i = 0; i < count; ++i)
+            {
+                const double distance = (candidates[i].point - candidates[deepest].point).magnitude_squared();
+                if (distance > furthest_distance)
+                {
+                    furthest = i;
+                    furthest_distance = distance;
+                }
+            }
+
+            if (furthest != deepest)
+            {
+                manifold.points[manifold.count++] = candidates[furthest];
+            }
+        }
+
+    protected:
+        ContactPoint candidates[MAX_CANDIDATES];
+        size_t count;
+    };
+
+    /**
+     * @brief finds the candidate contacts between a convex polygon and a height field
+     * @param shape the polygon shape
+     * @param bounds the polygon bounding box
+     * @param field the height field
+     * @param reducer the reducer to add candidates to
+     */
+    void collide_polygon(
+        const CollisionShape& shape,
+        const BoundingBox& bounds,
+        HeightField& field,
+        ContactReducer& reducer)
+    {
+        const size_t vertex_count = shape.vertex_count;
+        if (vertex_count < 3)
+        {
+            return;
+        }
+
+        // Add each vertex below the surface, with the depth measured along the surface normal
+        double vertex_xs[CollisionShape::MAX_VERTICES];
+        double vertex_heights[CollisionShape::MAX_VERTICES];
+        Vector2 vertex_normals[CollisionShape::MAX_VERTICES];
+
+        for (size_t i = 0; i < vertex_count; ++i)
+        {
+            vertex_xs[i] = shape.vertices[i].x;
+        }
+
+        field.sample(
+            gio::Span<const double>(vertex_xs, vertex_count),
+            gio::Span<double>(vertex_heights, vertex_count),
+            gio::Span<Vector2>(vertex_normals, vertex_count));
+
+        for (size_t i = 0; i < vertex_count; ++i)
+        {
+            const double depth = shape.vertices[i].y - vertex_heights[i];
+            if (depth > 0.0)
+            {
+                reducer.add(
+                    shape.vertices[i],
+                    vertex_normals[i],
+                    -depth * vertex_normals[i].y);
+            }
+        }
+
+        // Define the outward unit normal of each edge, skipping degenerate edges
+        Vector2 edge_normals[CollisionShape::MAX_VERTICES];
+        bool edge_valid[CollisionShape::MAX_VERTICES];
+
+        for (size_t i = 0; i < vertex_count; ++i)
+        {
+            const Vector2& a = shape.vertices[i];
+            const Vector2& b = shape.vertices[(i + 1) % vertex_count];
+
+            const Vector2 edge_normal = Vector2(b.y - a.y, a.x - b.x);
+            const double length = edge_normal.magnitude();
+
+            edge_valid[i] = length > 0.0;
+            if (edge_valid[i])
+            {
+                edge_normals[i] = edge_normal / length;
+                if ((shape.center - a).dot(edge_normals[i]) > 0.0)
+                {
+                    edge_normals[i] = -edge_normals[i];
+                }
+            }
+        }
+
+        // Add each surface sample point inside the polygon, pushed out through the nearest edge
+        const double spacing = field.get_sample_spacing();
+        const long first_sample = static_cast<long>(std::ceil(bounds.min.x / spacing));
+        const long last_sample = static_cast<long>(std::floor(bounds.max.x / spacing));
+
+        double surface_xs[SURFACE_BATCH];
+        double surface_heights[SURFACE_BATCH];
+
+        for (long batch_start = first_sample; batch_start <= last_sample; batch_start += static_cast<long>(SURFACE_BATCH))
+        {
+            const size_t batch_count = static_cast<size_t>(std::min<long>(static_cast<long>(SURFACE_BATCH), last_sample - batch_start + 1));
+
+            for (size_t j = 0; j < batch_count; ++j)
+            {
+                surface_xs[j] = static_cast<double>(batch_start + static_cast<long>(j)) * spacing;
+            }
+
+            field.sample(
+                gio::Span<const double>(surface_xs, batch_count),
+                gio::Span<double>(surface_heights, batch_count),
+                gio::Span<Vector2>());
+
+            for (size_t j = 0; j < batch_count; ++j)
+            {
+                const Vector2 surface_point(surface_xs[j], surface_heights[j]);
+                if (surface_point.y >= bounds.max.y)
+                {
+                    continue;
+                }
+
+                // Find the edge the point is closest to the outside of
+                double nearest_distance = 0.0;
+                size_t nearest_edge = vertex_count;
+
+                for (size_t i = 0; i < vertex_count; ++i)
+                {
+                    if (!edge_valid[i])
+                    {
+                        continue;
+                    }
+
+                    const double distance = (surface_point - shape.vertices[i]).dot(edge_normals[i]);
+                    if (nearest_edge == vertex_count || distance > nearest_distance)
+                    {
+                        nearest_edge = i;
+                        nearest_distance = distance;
+                    }
+                }
+
+                if (nearest_edge < vertex_count && nearest_distance < 0.0)
+                {
+                    reducer.add(
+                        surface_point,
+                        -edge_normals[nearest_edge],
+                        -nearest_distance);
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief finds the contact between a circle and a height field
+     * @param shape the circle shape
+     * @param field the height field
+     * @param reducer the reducer to add the contact to
+     */
+    void collide_circle(
+        const CollisionShape& shape,
+        HeightField& field,
+        ContactReducer& reducer)
+    {
+        const Vector2& center = shape.center;
+
+        // Determine whether the center itself is below the surface
+        double center_height = 0.0;
+        Vector2 center_normal;
+
+        field.sample(
+            gio::Span<const double>(&center.x, 1),
+            gio::Span<double>(&center_height, 1),
+            gio::Span<Vector2>(&center_normal, 1));
+
+        const bool center_below = center.y > center_height;
+
+        // Find the closest point on the surface polyline, over every segment reaching under the circle
+        const double spacing = field.get_sample_spacing();
+        const long first_sample = static_cast<long>(std::floor((center.x - shape.radius) / spacing));
+        const long last_sample = static_cast<long>(std::ceil((center.x + shape.radius) / spacing));
+
+        double surface_xs[SURFACE_BATCH];
+        double surface_heights[SURFACE_BATCH];
+
+        Vector2 closest_point;
+        double closest_distance_squared = -1.0;
+
+        Vector2 previous_point;
+        bool has_previous = false;
+
+        for (long batch_start = first_sample; batch_start <= last_sample; batch_start += static_cast<long>(SURFACE_BATCH))
+        {
+            const size_t batch_count = static_cast<size_t>(std::min<long>(static_cast<long>(SURFACE_BATCH), last_sample - batch_start + 1));
+
+            for (size_t j = 0; j < batch_count; ++j)
+            {
+                surface_xs[j] = static_cast<double>(batch_start + static_cast<long>(j)) * spacing;
+            }
+
+            field.sample(
+                gio::Span<const double>(surface_xs, batch_count),
+                gio::Span<double>(surface_heights, batch_count),
+                gio::Span<Vector2>());
+
+            for (size_t j = 0; j < batch_count; ++j)
+            {
+                const Vector2 point(surface_xs[j], surface_heights[j]);
+
+                if (has_previous)
+                {
+                    // Project the center onto the segment
+                    const Vector2 segment = point - previous_point;
+                    const double length_squared = segment.magnitude_squared();
+                    const double t = (length_squared > 0.0) ? std::min(std::max((center - previous_point).dot(segment) / length_squared, 0.0), 1.0) : 0.0;
+
+                    const Vector2 candidate = previous_point + segment * t;
+                    const double distance_squared = (center - candidate).magnitude_squared();
+
+                    if (closest_distance_squared < 0.0 || distance_squared < closest_distance_squared)
+                    {
+                        closest_point = candidate;
+                        closest_distance_squared = distance_squared;
+                    }
+                }
+
+                previous_point = point;
+                has_previous = true;
+            }
+        }
+
+        if (closest_distance_squared < 0.0)
+        {
+            return;
+        }
+
+        // Push the circle out along the line from the closest point, or along the surface normal if the
+        // center lies exactly on the surface
+        const double distance = std::sqrt(closest_distance_squared);
+
+        if (center_below)
+        {
+            const Vector2 normal = (distance > 0.0) ? (closest_point - center) / distance : center_normal;
+            reducer.add(closest_point, normal, shape.radius + distance);
+        }
+        else if (distance < shape.radius)
+        {
+            const Vector2 normal = (distance > 0.0) ? (center - closest_point) / distance : center_normal;
+            reducer.add(closest_point, normal, shape.radius - distance);
+        }
+    }
+
+    /**
+     * @brief provides the outward unit normal of a polygon edge
+     * @param shape the polygon shape
+     * @param edge the index of the edge, which runs from the vertex of the same index to the next vertex
+     * @return the outward normal, or a zero vector if the edge is degenerate
+     */
+    Vector2 outward_edge_normal(
+        const CollisionShape& shape,
+        const size_t edge)
+    {
+        const Vector2& a = shape.vertices[edge];
+        const Vector2& b = shape.vertices[(edge + 1) % shape.vertex_count];
+
+        const Vector2 edge_normal = Vector2(b.y - a.y, a.x - b.x);
+        const double length = edge_normal.magnitude();
+
+        if (length <= 0.0)
+        {
+            return Vector2();
+        }
+
+        const Vector2 normal = edge_normal / length;
+        return ((shape.center - a).dot(normal) > 0.0) ? -normal : normal;
+    }
+
+    /**
+     * @brief finds the contact between two circles
+     * @param a the first circle
+     * @param b the second circle
+     * @param manifold set to the contact, with the normal pointing from a towards b
+     */
+    void collide_circles(
+        const CollisionShape& a,
+        const CollisionShape& b,
+        ContactManifold& manifold)
+    {
+        const Vector2 delta = b.center - a.center;
+        const double distance = delta.magnitude();
+        const double penetration = a.radius + b.radius - distance;
+
+        if (penetration <= 0.0)
+        {
+            return;
+        }
+
+        // Separate coincident circles vertically, which is as good a direction as any
+        const Vector2 normal = (distance > 0.0) ? delta / distance : Vector2(0.0, -1.0);
+
+        ContactPoint& contact = manifold.points[manifold.count++];
+        contact.point = a.center + normal * (a.radius - 0.5 * penetration);
+        contact.normal = normal;
+        contact.penetration = penetration;
+    }
+
+    /**
+     * @brief finds the contact between a convex polygon and a circle
+     * @param polygon the polygon shape
+     * @param circle the circle shape
+     * @param manifold set to the contact, with the normal pointing from the polygon towards the circle
+     */
+    void collide_polygon_circle(
+        const CollisionShape& polygon,
+        const CollisionShape& circle,
+        ContactManifold& manifold)
+    {
+        const size_t vertex_count = polygon.vertex_count;
+        if (vertex_count < 3)
+        {
+            return;
+        }
+
+        // Find the edge the circle center is furthest outside of
+        size_t nearest_edge = vertex_count;
+        double separation = 0.0;
+        Vector2 nearest_normal;
+
+        for (size_t i = 0; i < vertex_count; ++i)
+        {
+            const Vector2 normal = outward_edge_normal(polygon, i);
+            if (normal.magnitude_squared() <= 0.0)
+            {
+                continue;
+            }
+
+            const double distance = (circle.center - polygon.vertices[i]).dot(normal);
+            if (nearest_edge == vertex_count || distance > separation)
+            {
+                nearest_edge = i;
+                separation = distance;
+                nearest_normal = normal;
+            }
+        }
+
+        if (nearest_edge == vertex_count || separation > circle.radius)
+        {
+            return;
+        }
+
+        // Push a center inside the polygon straight out through the nearest edge
+        if (separation <= 0.0)
+        {
+            ContactPoint& contact = manifold.points[manifold.count++];
+            contact.point = circle.center - nearest_normal * separation;
+            contact.normal = nearest_normal;
+            contact.penetration = circle.radius - separation;
+            return;
+        }
+
+        // Otherwise use the closest point on the nearest edge, which may be one of its vertices
+        const Vector2& a = polygon.vertices[nearest_edge];
+        const Vector2& b = polygon.vertices[(nearest_edge + 1) % vertex_count];
+
+        const Vector2 edge = b - a;
+        const double t = std::min(std::max((circle.center - a).dot(edge) / edge.magnitude_squared(), 0.0), 1.0);
+
+        const Vector2 closest = a + edge * t;
+        const Vector2 delta = circle.center - closest;
+        const double distance = delta.magnitude();
+
+        if (distance >= circle.radius)
+        {
+            return;
+        }
+
+        ContactPoint& contact = manifold.points[manifold.count++];
+        contact.point = closest;
+        contact.normal = (distance > 0.0) ? delta / distance : nearest_normal;
+        contact.penetration = circle.radius - distance;
+    }
+
+    /**
+     * @brief finds the edge of one polygon that the other polygon lies furthest outside of
+     * @param a the polygon to take the edges from
+     * @param b the other polygon
+     * @param edge set to the index of the edge
+     * @return the separation along the edge normal, which is negative if the polygons overlap along it
+     */
+    double max_separation(
+        const CollisionShape& a,
+        const CollisionShape& b,
+        size_t& edge)
+    {
+        double best = 0.0;
+        edge = a.vertex_count;
+
+        for (size_t i = 0; i < a.vertex_count; ++i)
+        {
+            const Vector2 normal = outward_edge_normal(a, i);
+            if (normal.magnitude_squared() <= 0.0)
+            {
+                continue;
+            }
+
+            // The separation along an edge is set by the vertex of b that reaches furthest into a
+            double separation = (b.vertices[0] - a.vertices[i]).dot(normal);
+            for (size_t j = 1; j < b.vertex_count; ++j)
+            {
+                separation = std::min(separation, (b.vertices[j] - a.vertices[i]).dot(normal));
+            }
+
+            if (edge == a.vertex_count || separation > best)
+            {
+                best = separation;
+                edge = i;
+            }
+        }
+
+        return best;
+    }
+
+    /**
+     * @brief finds the contacts between two convex polygons
+     * @param a the first polygon
+     * @param b the second polygon
+     * @param manifold set to the contacts, with normals pointing from a towards b
+     */
+    void collide_polygons(
+        const CollisionShape& a,
+        const CollisionShape& b,
+        ContactManifold& manifold)
+    {
+        if (a.vertex_count < 3 || b.vertex_count < 3)
+        {
+            return;
+        }
+
+        size_t edge_a = 0;
+        size_t edge_b = 0;
+
+        const double separation_a = max_separation(a, b, edge_a);
+        const double separation_b = max_separation(b, a, edge_b);
+
+        if (edge_a == a.vertex_count || edge_b == b.vertex_count || separation_a > 0.0 || separation_b > 0.0)
+        {
+            return;
+        }
+
+        // Use the edge with the least overlap as the reference, preferring a so that the choice does not
+        // flip back and forth between two nearly equal edges
+        const bool reference_is_a = separation_a >= separation_b - REFERENCE_TOLERANCE;
+
+        const CollisionShape& reference = reference_is_a ? a : b;
+        const CollisionShape& incident = reference_is_a ? b : a;
+        const size_t reference_edge = reference_is_a ? edge_a : edge_b;
+
+        const Vector2 normal = outward_edge_normal(reference, reference_edge);
+        const Vector2& ref_start = reference.vertices[reference_edge];
+        const Vector2& ref_end = reference.vertices[(reference_edge + 1) % reference.vertex_count];
+
+        // Find the incident edge, which faces most directly against the reference edge
+        size_t incident_edge = 0;
+        double min_dot = 0.0;
+
+        for (size_t i = 0; i < incident.vertex_count; ++i)
+        {
+            const double dot = outward_edge_normal(incident, i).dot(normal);
+            if (i == 0 || dot < min_dot)
+            {
+                incident_edge = i;
+                min_dot = dot;
+            }
+        }
+
+        Vector2 clipped[2] = {
+            incident.vertices[incident_edge],
+            incident.vertices[(incident_edge + 1) % incident.vertex_count]
+        };
+
+        // Clip the incident edge to the sides of the reference edge
+        const Vector2 tangent = (ref_end - ref_start).normalize();
+        const double side_limits[2] = { tangent.dot(ref_start), -tangent.dot(ref_end) };
+        const Vector2 side_normals[2] = { tangent, -tangent };
+
+        for (size_t side = 0; side < 2; ++side)
+        {
+            // Measure how far each point lies inside the side plane
+            const double d0 = side_normals[side].dot(clipped[0]) - side_limits[side];
+            const double d1 = side_normals[side].dot(clipped[1]) - side_limits[side];
+
+            if (d0 < 0.0 && d1 < 0.0)
+            {
+                return;
+            }
+
+            if (d0 < 0.0)
+            {
+                clipped[0] = clipped[0] + (clipped[1] - clipped[0]) * (d0 / (d0 - d1));
+            }
+            else if (d1 < 0.0)
+            {
+                clipped[1] = clipped[1] + (clipped[0] - clipped[1]) * (d1 / (d1 - d0));
+            }
+        }
+
+        // Keep each clipped point that lies behind the reference edge
+        for (size_t i = 0; i < 2; ++i)
+        {
+            const double separation = (clipped[i] - ref_start).dot(normal);
+            if (separation < 0.0)
+            {
+                ContactPoint& contact = manifold.points[manifold.count++];
+                contact.point = clipped[i];
+                contact.normal = reference_is_a ? normal : -normal;
+                contact.penetration = -separation;
+            }
+        }
+    }
+}
+
+CollisionShape CollisionShape::circle(
+    const Vector2& center,
+    const double radius)
+{
+    CollisionShape shape;
+    shape.type = Type::CIRCLE;
+    shape.center = center;
+    shape.radius = radius;
+    return shape;
+}
+
+CollisionShape CollisionShape::polygon(gio::Span<const Vector2> vertices)
+{
+    CollisionShape shape;
+    shape.type = Type::POLYGON;
+    shape.vertex_count = (vertices.size() < MAX_VERTICES) ? vertices.size() : MAX_VERTICES;
+
+    // Keep the vertices, and use their average as a point inside the convex polygon
+    Vector2 sum;
+    for (size_t i = 0; i < shape.vertex_count; ++i)
+    {
+        shape.vertices[i] = vertices[i];
+        sum += vertices[i];
+    }
+
+    if (shape.vertex_count > 0)
+    {
+        shape.center = sum / static_cast<double>(shape.vertex_count);
+    }
+
+    // Define the radius of the circle around the center that contains the polygon
+    for (size_t i = 0; i < shape.vertex_count; ++i)
+    {
+        shape.radius = std::max(shape.radius, shape.center.distance_to(shape.vertices[i]));
+    }
+
+    return shape;
+}
+
+CollisionShape CollisionShape::polygon(const Polygon& polygon)
+{
+    return CollisionShape::polygon(gio::Span<const Vector2>(polygon.get_points()));
+}
+
+BoundingBox CollisionShape::get_bounding_box() const
+{
+    if (type == Type::CIRCLE)
+    {
+        return BoundingBox::around_circle(center, radius);
+    }
+
+    BoundingBox bounds(center, center);
+    for (size_t i = 0; i < vertex_count; ++i)
+    {
+        bounds.expand(vertices[i]);
+    }
+
+    return bounds;
+}
+
+namespace gio
+{
+    void collide_heightfield(
+        const CollisionShape& shape,
+        HeightField& field,
+        ContactManifold& manifold)
+    {
+        manifold.count = 0;
+
+        // Rule out shapes which lie entirely above the highest ground beneath them
+        const BoundingBox bounds = shape.get_bounding_box();
+        if (bounds.max.y <= field.highest_point_between(bounds.min.x, bounds.max.x))
+        {
+            return;
+        }
+
+        // Find the candidate contacts for the shape type and reduce them to the manifold
+        ContactReducer reducer;
+
+        if (shape.type == CollisionShape::Type::CIRCLE)
+        {
+            collide_circle(shape, field, reducer);
+        }
+        else
+        {
+            collide_polygon(shape, bounds, field, reducer);
+        }
+
+        reducer.finish(manifold);
+    }
+
+    void collide_shapes(
+        const CollisionShape& a,
+        const CollisionShape& b,
+        ContactManifold& manifold)
+    {
+        manifold.count = 0;
+
+        // Rule out shapes whose bounding circles do not touch
+        if (a.center.distance_to(b.center) >= a.radius + b.radius)
+        {
+            return;
+        }
+
+        // Find the contacts for the pair of shape types, flipping the normals if the pair was swapped
+        if (a.type == CollisionShape::Type::CIRCLE && b.type == CollisionShape::Type::CIRCLE)
+        {
+            collide_circles(a, b, manifold);
+        }
+        else if (a.type == CollisionShape::Type::POLYGON && b.type == CollisionShape::Type::CIRCLE)
+        {
+            collide_polygon_circle(a, b, manifold);
+        }
+        else if (a.type == CollisionShape::Type::CIRCLE && b.type == CollisionShape::Type::POLYGON)
+        {
+            collide_polygon_circle(b, a, manifold);
+            for (size_t i = 0; i < manifold.count; ++i)
+            {
+                manifold.points[i].normal = -manifold.points[i].normal;
+            }
+        }
+        else
+        {
+            collide_polygons(a, b, manifold);
+        }
+    }
+}
@@ -0,0 +1,142 @@
+#ifndef GIO_COLLISION_H
+#define GIO_COLLISION_H
+
+#include <gamelib/bounding_box.h>
+#include <gamelib/height_field.h>
+#include <gamelib/polygon.h>
+#include <gamelib/span.h>
+#include <gamelib/vector2.h>
+
+#include <cstddef>
+
+/**
+ * @brief a single point of contact, with the unit normal along which the body must move to separate
+ * and the distance it must move
+ */
+struct ContactPoint
+{
+    Vector2 point;
+    Vector2 normal;
+    double penetration = 0.0;
+};
+
+/**
+ * @brief the contact points between a body and another surface. In two dimensions the contact between
+ * a convex shape and a locally straight surface is spanned by two points, so the manifold keeps the
+ * deepest contact and the contact furthest from it
+ */
+struct ContactManifold
+{
+    static const size_t MAX_POINTS = 2;
+
+    ContactPoint points[MAX_POINTS];
+    size_t count = 0;
+};
+
+/**
+ * @brief a convex collision shape in global coordinates, which is either a circle or a convex polygon
+ * with its vertices in order around the boundary
+ */
+struct CollisionShape
+{
+    enum class Type
+    {
+        CIRCLE,
+        POLYGON
+    };
+
+    static const size_t MAX_VERTICES = 8;
+
+    /**
+     * @brief constructs a circle shape
+     * @param center the circle center
+     * @param radius the circle radius
+     * @return the collision shape
+     */
+    static CollisionShape circle(
+        const Vector2& center,
+        const double radius);
+
+    /**
+     * @brief constructs a convex polygon shape, keeping at most MAX_VERTICES vertices
+     * @param vertices the vertices in order around the boundary
+     * @return the collision shape
+     */
+    static CollisionShape polygon(gio::Span<const Vector2> vertices);
+
+    /**
+     * @brief constructs a convex polygon shape from the points of a polygon
+     * @param polygon the convex polygon
+     * @return the collision shape
+     */
+    static CollisionShape polygon(const Polygon& polygon);
+
+    /**
+     * @brief provides the axis-aligned box around the shape
+     * @return the bounding box
+     */
+    BoundingBox get_bounding_box() const;
+
+    Type type = Type::CIRCLE;
+
+    Vector2 center;
+    double radius = 0.0;
+
+    Vector2 vertices[MAX_VERTICES];
+    size_t vertex_count = 0;
+};
+
+/**
+ * @brief An interface for an object that can provide its collision shape
+ */
+class Collider
+{
+public:
+    /**
+     * @brief provides the current collision shape of the object
+     * @return the collision shape in global coordinates
+     */
+    virtual CollisionShape get_collision_shape() const = 0;
+
+    /**
+     * @brief virtual destructor
+     */
+    virtual ~Collider()
+    {
+        // Empty Destructor
+    }
+};
+
+namespace gio
+{
+    /**
+     * @brief finds the contacts between a shape and the ground below a height field. Polygon contacts
+     * come from the polygon vertices below the surface and from the surface sample points inside the
+     * polygon, which together cover every crossing between the polygon and the surface polyline. Circle
+     * contacts come from the closest point on the surface polyline
+     * @param shape the shape to test
+     * @param field the height field to test against
+     * @param manifold set to the resulting contacts, with count 0 if there are none
+     */
+    void collide_heightfield(
+        const CollisionShape& shape,
+        HeightField& field,
+        ContactManifold& manifold);
+
+    /**
+     * @brief finds the contacts between two convex shapes. Circle pairs touch at a single point, circles
+     * and polygons touch at the closest point of the polygon boundary, and polygon pairs are separated
+     * along the edge normal with the least overlap, with the incident edge of the other polygon clipped
+     * to the reference edge to give up to two points
+     * @param a the first shape
+     * @param b the second shape
+     * @param manifold set to the resulting contacts, with normals pointing from a towards b so that each
+     * normal is the direction that b must move to separate, with count 0 if there are none
+     */
+    void collide_shapes(
+        const CollisionShape& a,
+        const CollisionShape& b,
+        ContactManifold& manifold);
+}
+
+#endif // GIO_COLLISION_H
@@ -0,0 +1,508 @@
+#include <gamelib/collision_world.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    /**
+     * @brief the overlap left in place by the position solve, so that resting contacts stay touching
+     * and are found again by the next update
+     */
+    const double POSITION_SLOP = 0.05;
+
+    /**
+     * @brief the fraction of the remaining overlap removed by each position solve
+     */
+    const double POSITION_FRACTION = 0.8;
+
+    /**
+     * @brief the number of passes over all contacts made by each velocity solve
+     */
+    const size_t VELOCITY_ITERATIONS = 4;
+
+    /**
+     * @brief the friction coefficient between colliding bodies
+     */
+    const double FRICTION_COEFFICIENT = 0.25;
+
+    /**
+     * @brief the largest number of colliders tested against each other directly, for which building the
+     * grid costs more than the pair tests it would save
+     */
+    const size_t DIRECT_PAIR_LIMIT = 8;
+
+    /**
+     * @brief the smallest number of hash buckets in the grid
+     */
+    const size_t MIN_BUCKETS = 16;
+
+    /**
+     * @brief the hash multipliers for the grid cell coordinates
+     */
+    const uint64_t CELL_HASH_X = 0x9e3779b97f4a7c15ull;
+    const uint64_t CELL_HASH_Y = 0xc2b2ae3d27d4eb4full;
+
+    /**
+     * @brief rounds a value down to the nearest integer, without the cost of std::floor
+     */
+    inline long floor_to_long(const double value)
+    {
+        const long truncated = static_cast<long>(value);
+        return (value < static_cast<double>(truncated)) ? truncated - 1 : truncated;
+    }
+
+    /**
+     * @brief provides the number of hash buckets used for a number of cell entries, which is at least
+     * twice the number of entries so that few cells share a bucket
+     */
+    inline size_t bucket_count_for(const size_t cell_entry_count)
+    {
+        size_t bucket_count = MIN_BUCKETS;
+        while (bucket_count < 2 * cell_entry_count)
+        {
+            bucket_count *= 2;
+        }
+
+        return bucket_count;
+    }
+
+    /**
+     * @brief makes room for at least the given number of values, with room to spare when growing so
+     * that small changes in the count do not allocate again
+     */
+    template <typename T>
+    inline void reserve_with_headroom(
+        std::vector<T>& values,
+        const size_t count)
+    {
+        if (values.capacity() < count)
+        {
+            values.reserve(2 * count);
+        }
+    }
+
+    /**
+     * @brief provides the inverse mass of a body, which is 0 for a fixed obstacle
+     */
+    inline double inverse_mass(const PhysicsBody* body)
+    {
+        return (body != nullptr) ? 1.0 / body->get_mass() : 0.0;
+    }
+
+    /**
+     * @brief provides the inverse inertia of a body, which is 0 for a fixed obstacle
+     */
+    inline double inverse_inertia(const PhysicsBody* body)
+    {
+        return (body != nullptr) ? 1.0 / body->get_inertia() : 0.0;
+    }
+
+    /**
+     * @brief provides the velocity of a body at a point, which is 0 for a fixed obstacle
+     */
+    inline Vector2 velocity_at(
+        const PhysicsBody* body,
+        const Vector2& point)
+    {
+        return (body != nullptr) ? body->get_velocity_at_absolute(point) : Vector2();
+    }
+
+    /**
+     * @brief provides the offset from the center of a body to a point, which is 0 for a fixed obstacle
+     */
+    inline Vector2 offset_from(
+        const PhysicsBody* body,
+        const Vector2& point)
+    {
+        return (body != nullptr) ? point - body->get_position() : Vector2();
+    }
+
+    /**
+     * @brief computes the effective mass of two bodies along a direction at a point
+     */
+    inline double effective_mass(
+        const PhysicsBody* body_a,
+        const PhysicsBody* body_b,
+        const Vector2& offset_a,
+        const Vector2& offset_b,
+        const Vector2& direction)
+    {
+        const double arm_a = offset_a.cross(direction);
+        const double arm_b = offset_b.cross(direction);
+
+        return
+            inverse_mass(body_a) + inverse_mass(body_b) +
+            arm_a * arm_a * inverse_inertia(body_a) +
+            arm_b * arm_b * inverse_inertia(body_b);
+    }
+
+    /**
+     * @brief applies equal and opposite impulses to the bodies of a contact
+     */
+    inline void apply_contact_impulse(
+        PhysicsBody* body_a,
+        PhysicsBody* body_b,
+        const Vector2& offset_a,
+        const Vector2& offset_b,
+        const Vector2& impulse)
+    {
+        if (body_a != nullptr)
+        {
+            body_a->apply_impulse(-impulse, offset_a);
+        }
+
+        if (body_b != nullptr)
+        {
+            body_b->apply_impulse(impulse, offset_b);
+        }
+    }
+}
+
+CollisionWorld::CollisionWorld(const double cell_size) :
+    cell_size(cell_size),
+    inv_cell_size(1.0 / cell_size),
+    bucket_mask(0),
+    pair_test_count(0)
+{
+    // Empty Constructor
+}
+
+size_t CollisionWorld::add(
+    PhysicsBody* body,
+    const Collider* collider)
+{
+    Entry entry;
+    entry.body = body;
+    entry.collider = collider;
+
+    entries.push_back(entry);
+    return entries.size() - 1;
+}
+
+void CollisionWorld::clear()
+{
+    entries.clear();
+    contacts.clear();
+}
+
+size_t CollisionWorld::size() const
+{
+    return entries.size();
+}
+
+void CollisionWorld::update()
+{
+    // Read the current shape of each collider
+    for (Entry& entry : entries)
+    {
+        entry.shape = entry.collider->get_collision_shape();
+        entry.bounds = entry.shape.get_bounding_box();
+    }
+
+    // Test small worlds, such as a single balloon, directly
+    if (entries.size() <= DIRECT_PAIR_LIMIT)
+    {
+        contacts.clear();
+        pair_test_count = 0;
+
+        for (size_t i = 0; i < entries.size(); ++i)
+        {
+            for (size_t j = i + 1; j < entries.size(); ++j)
+            {
+                if (entries[i].bounds.overlaps(entries[j].bounds))
+                {
+                    test_pair(i, j);
+                }
+            }
+        }
+
+        return;
+    }
+
+    build_grid();
+    find_contacts();
+}
+
+void CollisionWorld::build_grid()
+{
+    // Make room for the most cells that each collider could cover at its current size, wherever it is
+    // placed, so that the grid only allocates when the colliders grow rather than whenever they move
+    size_t cell_capacity = 0;
+    for (const Entry& entry : entries)
+    {
+        const BoundingBox& bounds = entry.bounds;
+
+        const size_t x_cells = static_cast<size_t>((bounds.max.x - bounds.min.x) * inv_cell_size) + 2;
+        const size_t y_cells = static_cast<size_t>((bounds.max.y - bounds.min.y) * inv_cell_size) + 2;
+        cell_capacity += x_cells * y_cells;
+    }
+
+    reserve_with_headroom(cell_entries, cell_capacity);
+    reserve_with_headroom(sorted_cell_entries, cell_capacity);
+    reserve_with_headroom(bucket_starts, bucket_count_for(cell_capacity) + 1);
+
+    // Collect each cell covered by each collider
+    cell_entries.clear();
+
+    for (size_t i = 0; i < entries.size(); ++i)
+    {
+        const BoundingBox& bounds = entries[i].bounds;
+
+        const long x_min = cell_index(bounds.min.x);
+        const long x_max = cell_index(bounds.max.x);
+        const long y_min = cell_index(bounds.min.y);
+        const long y_max = cell_index(bounds.max.y);
+
+        for (long cell_y = y_min; cell_y <= y_max; ++cell_y)
+        {
+            for (long cell_x = x_min; cell_x <= x_max; ++cell_x)
+            {
+                CellEntry cell_entry;
+                cell_entry.cell_x = cell_x;
+                cell_entry.cell_y = cell_y;
+                cell_entry.index = i;
+
+                cell_entries.push_back(cell_entry);
+            }
+        }
+    }
+
+    // Size the table to at least twice the number of cell entries, so that few cells share a bucket
+    const size_t bucket_count = bucket_count_for(cell_entries.size());
+    bucket_mask = bucket_count - 1;
+
+    // Sort the cell entries by bucket with a counting sort
+    bucket_starts.assign(bucket_count + 1, 0);
+
+    for (const CellEntry& cell_entry : cell_entries)
+    {
+        ++bucket_starts[bucket_index(cell_entry.cell_x, cell_entry.cell_y) + 1];
+    }
+
+    for (size_t i = 0; i < bucket_count; ++i)
+    {
+        bucket_starts[i + 1] += bucket_starts[i];
+    }
+
+    sorted_cell_entries.resize(cell_entries.size());
+
+    for (const CellEntry& cell_entry : cell_entries)
+    {
+        sorted_cell_entries[bucket_starts[bucket_index(cell_entry.cell_x, cell_entry.cell_y)]++] = cell_entry;
+    }
+
+    // Restore the bucket starts, which the scatter moved to the start of the next bucket
+    for (size_t i = bucket_count; i > 0; --i)
+    {
+        bucket_starts[i] = bucket_starts[i - 1];
+    }
+    bucket_starts[0] = 0;
+}
+
+void CollisionWorld::find_contacts()
+{
+    contacts.clear();
+    pair_test_count = 0;
+
+    const size_t bucket_count = bucket_mask + 1;
+
+    for (size_t bucket = 0; bucket < bucket_count; ++bucket)
+    {
+        const size_t start = bucket_starts[bucket];
+        const size_t end = bucket_starts[bucket + 1];
+
+        for (size_t i = start; i < end; ++i)
+        {
+            const CellEntry& first = sorted_cell_entries[i];
+
+            for (size_t j = i + 1; j < end; ++j)
+            {
+                const CellEntry& second = sorted_cell_entries[j];
+
+                // Skip entries from other cells that share the bucket
+                if (first.cell_x != second.cell_x || first.cell_y != second.cell_y)
+                {
+                    continue;
+                }
+
+                const BoundingBox& bounds_a = entries[first.index].bounds;
+                const BoundingBox& bounds_b = entries[second.index].bounds;
+
+                if (!bounds_a.overlaps(bounds_b))
+                {
+                    continue;
+                }
+
+                // Only test the pair in the cell holding the corner of the overlap, so that a pair
+                // sharing several cells is tested once
+                const long corner_x = cell_index(std::max(bounds_a.min.x, bounds_b.min.x));
+                const long corner_y = cell_index(std::max(bounds_a.min.y, bounds_b.min.y));
+
+                if (corner_x != first.cell_x || corner_y != first.cell_y)
+                {
+                    continue;
+                }
+
+                // Test the pair in registration order, so that the contact normals do not depend on the grid
+                test_pair(
+                    std::min(first.index, second.index),
+                    std::max(first.index, second.index));
+            }
+        }
+    }
+}
+
+void CollisionWorld::test_pair(
+    const size_t index_a,
+    const size_t index_b)
+{
+    const Entry& a = entries[index_a];
+    const Entry& b = entries[index_b];
+
+    // Fixed obstacles never need to be separated from each other
+    if (a.body == nullptr && b.body == nullptr)
+    {
+        return;
+    }
+
+    ++pair_test_count;
+
+    ContactManifold manifold;
+    gio::collide_shapes(a.shape, b.shape, manifold);
+
+    for (size_t i = 0; i < manifold.count; ++i)
+    {
+        BodyContact contact;
+        contact.index_a = index_a;
+        contact.index_b = index_b;
+        contact.contact = manifold.points[i];
+        contact.share = 1.0 / static_cast<double>(manifold.count);
+
+        contacts.push_back(contact);
+    }
+}
+
+void CollisionWorld::solve_positions()
+{
+    for (const BodyContact& c : contacts)
+    {
+        PhysicsBody* body_a = entries[c.index_a].body;
+        PhysicsBody* body_b = entries[c.index_b].body;
+
+        const double correction = std::max(c.contact.penetration - POSITION_SLOP, 0.0) * POSITION_FRACTION * c.share;
+        if (correction <= 0.0)
+        {
+            continue;
+        }
+
+        const Vector2 offset_a = offset_from(body_a, c.contact.point);
+        const Vector2 offset_b = offset_from(body_b, c.contact.point);
+
+        const double k = effective_mass(body_a, body_b, offset_a, offset_b, c.contact.normal);
+        if (k <= 0.0)
+        {
+            continue;
+        }
+
+        // Push the bodies apart along the contact normal
+        const Vector2 impulse = c.contact.normal * (correction / k);
+
+        if (body_a != nullptr)
+        {
+            body_a->apply_position_impulse(-impulse, offset_a);
+        }
+
+        if (body_b != nullptr)
+        {
+            body_b->apply_position_impulse(impulse, offset_b);
+        }
+    }
+}
+
+void CollisionWorld::solve_velocities()
+{
+    for (BodyContact& c : contacts)
+    {
+        c.normal_impulse = 0.0;
+        c.tangent_impulse = 0.0;
+    }
+
+    for (size_t iteration = 0; iteration < VELOCITY_ITERATIONS; ++iteration)
+    {
+        for (BodyContact& c : contacts)
+        {
+            PhysicsBody* body_a = entries[c.index_a].body;
+            PhysicsBody* body_b = entries[c.index_b].body;
+
+            const Vector2& point = c.contact.point;
+            const Vector2& normal = c.contact.normal;
+            const Vector2 tangent(-normal.y, normal.x);
+
+            const Vector2 offset_a = offset_from(body_a, point);
+            const Vector2 offset_b = offset_from(body_b, point);
+
+            // Stop the bodies approaching along the normal, keeping the total impulse pushing
+            const double k_normal = effective_mass(body_a, body_b, offset_a, offset_b, normal);
+            if (k_normal <= 0.0)
+            {
+                continue;
+            }
+
+            const double normal_vel = (velocity_at(body_b, point) - velocity_at(body_a, point)).dot(normal);
+            const double normal_impulse = std::max(c.normal_impulse - normal_vel / k_normal, 0.0);
+
+            apply_contact_impulse(body_a, body_b, offset_a, offset_b, normal * (normal_impulse - c.normal_impulse));
+            c.normal_impulse = normal_impulse;
+
+            // Resist sliding along the surface, up to the friction limit of the normal impulse
+            const double k_tangent = effective_mass(body_a, body_b, offset_a, offset_b, tangent);
+            const double tangent_vel = (velocity_at(body_b, point) - velocity_at(body_a, point)).dot(tangent);
+
+            const double friction_limit = FRICTION_COEFFICIENT * c.normal_impulse;
+            const double tangent_impulse = std::min(std::max(c.tangent_impulse - tangent_vel / k_tangent, -friction_limit), friction_limit);
+
+            apply_contact_impulse(body_a, body_b, offset_a, offset_b, tangent * (tangent_impulse - c.tangent_impulse));
+            c.tangent_impulse = tangent_impulse;
+        }
+    }
+}
+
+void CollisionWorld::resolve()
+{
+    update();
+
+    if (contacts.empty())
+    {
+        return;
+    }
+
+    solve_positions();
+    solve_velocities();
+}
+
+const std::vector<BodyContact>& CollisionWorld::get_contacts() const
+{
+    return contacts;
+}
+
+size_t CollisionWorld::get_pair_test_count() const
+{
+    return pair_test_count;
+}
+
+long CollisionWorld::cell_index(const double value) const
+{
+    return floor_to_long(value * inv_cell_size);
+}
+
+size_t CollisionWorld::bucket_index(
+    const long cell_x,
+    const long cell_y) const
+{
+    const uint64_t hash =
+        static_cast<uint64_t>(cell_x) * CELL_HASH_X ^
+        static_cast<uint64_t>(cell_y) * CELL_HASH_Y;
+
+    return static_cast<size_t>(hash >> 32) & bucket_mask;
+}
@@ -0,0 +1,177 @@
+#ifndef GIO_COLLISION_WORLD_H
+#define GIO_COLLISION_WORLD_H
+
+#include <gamelib/bounding_box.h>
+#include <gamelib/collision.h>
+#include <gamelib/physics_object.h>
+#include <gamelib/vector2.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief a contact between two registered colliders, with the normal pointing from the first body
+ * towards the second
+ */
+struct BodyContact
+{
+    size_t index_a = 0;
+    size_t index_b = 0;
+
+    ContactPoint contact;
+
+    /**
+     * @brief the fraction of the position correction applied at this point, shared between the points
+     * of the same manifold so that a two point contact is not pushed apart twice
+     */
+    double share = 1.0;
+
+    double normal_impulse = 0.0;
+    double tangent_impulse = 0.0;
+};
+
+/**
+ * @brief Finds and resolves the contacts between many colliding bodies. Each collider is placed in
+ * every cell of a uniform grid that its bounding box covers, with the cells hashed into a table that
+ * is rebuilt by a counting sort on each update, so that only bodies sharing a cell are tested against
+ * each other and the cost grows close to linearly with the number of bodies. Contacts are resolved in
+ * the same way as DistanceConstraintSolver, by position impulses that remove the overlap followed by
+ * velocity impulses that stop the bodies approaching, so that bodies stored in different rigid body
+ * sets can collide after each set has been integrated
+ */
+class CollisionWorld
+{
+public:
+    /**
+     * @brief constructs an empty collision world
+     * @param cell_size the width and height of each grid cell, which works best when slightly larger
+     * than the typical collider
+     */
+    explicit CollisionWorld(const double cell_size = 64.0);
+
+    /**
+     * @brief registers a collider
+     * @param body the body to move when resolving contacts, or nullptr for a fixed obstacle
+     * @param collider the collider providing the shape, which must outlive its registration
+     * @return the index of the collider, used to identify it in each contact
+     */
+    size_t add(
+        PhysicsBody* body,
+        const Collider* collider);
+
+    /**
+     * @brief removes all colliders
+     */
+    void clear();
+
+    /**
+     * @brief provides the number of registered colliders
+     * @return the collider count
+     */
+    size_t size() const;
+
+    /**
+     * @brief reads the current shape of every collider and finds all contacts between them
+     */
+    void update();
+
+    /**
+     * @brief moves and rotates the bodies of each contact found by the last update apart
+     */
+    void solve_positions();
+
+    /**
+     * @brief applies impulses so that the bodies of each contact found by the last update stop
+     * approaching each other, with friction along the contact surface
+     */
+    void solve_velocities();
+
+    /**
+     * @brief runs update, solve_positions and solve_velocities, for use after every body has been stepped
+     */
+    void resolve();
+
+    /**
+     * @brief provides the contacts found by the last update
+     * @return the contacts
+     */
+    const std::vector<BodyContact>& get_contacts() const;
+
+    /**
+     * @brief provides the number of exact shape tests run by the last update, which shows how well the
+     * grid is culling pairs
+     * @return the number of shape tests
+     */
+    size_t get_pair_test_count() const;
+
+protected:
+    /**
+     * @brief a collider registration and its state for the current update
+     */
+    struct Entry
+    {
+        PhysicsBody* body;
+        const Collider* collider;
+
+        CollisionShape shape;
+        BoundingBox bounds;
+    };
+
+    /**
+     * @brief a single grid cell covered by a collider
+     */
+    struct CellEntry
+    {
+        long cell_x;
+        long cell_y;
+        size_t index;
+    };
+
+    /**
+     * @brief places each collider into the cells its bounding box covers, sorted by hash bucket
+     */
+    void build_grid();
+
+    /**
+     * @brief tests each pair of colliders sharing a cell, once for each pair
+     */
+    void find_contacts();
+
+    /**
+     * @brief tests a single pair of colliders, adding any contacts found
+     * @param index_a the index of the first collider
+     * @param index_b the index of the second collider
+     */
+    void test_pair(
+        const size_t index_a,
+        const size_t index_b);
+
+    /**
+     * @brief determines the grid cell containing a location
+     */
+    long cell_index(const double value) const;
+
+    /**
+     * @brief determines the hash bucket of a grid cell
+     */
+    size_t bucket_index(
+        const long cell_x,
+        const long cell_y) const;
+
+protected:
+    double cell_size;
+    double inv_cell_size;
+
+    std::vector<Entry> entries;
+
+    std::vector<CellEntry> cell_entries;
+    std::vector<CellEntry> sorted_cell_entries;
+    std::vector<size_t> bucket_starts;
+    size_t bucket_mask;
+
+    std::vector<BodyContact> contacts;
+    size_t pair_test_count;
+};
+
+#endif // GIO_COLLISION_WORLD_H
@@ -1,3 +0,0 @@
-#include <gamelib/constants.h>
-
-const double gio::pi = 3.14159265358979323846264338327950288419716;
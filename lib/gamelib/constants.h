@@ -4,7 +4,7 @@
 namespace gio
 {
 
-    extern const double pi;
+    constexpr double pi = 3.14159265358979323846264338327950288419716;
 
 }
 
@@ -0,0 +1,296 @@
+#include <gamelib/distance_constraint.h>
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+namespace
+{
+    /**
+     * @brief the fraction of its length that a constraint may be slack by and still be considered taut
+     */
+    const double TAUT_TOLERANCE = 1e-3;
+}
+
+DistanceConstraintSolver::DistanceConstraintSolver()
+{
+    // Empty Constructor
+}
+
+void DistanceConstraintSolver::clear()
+{
+    constraints.clear();
+}
+
+void DistanceConstraintSolver::add(const DistanceConstraint& constraint)
+{
+    constraints.push_back(constraint);
+}
+
+void DistanceConstraintSolver::solve_positions()
+{
+    compute_jacobians();
+
+    // Activate each stretched constraint, using the stretch as the amount to remove
+    const size_t count = constraints.size();
+    rhs_values.resize(count);
+    active.assign(count, false);
+    candidate.assign(count, false);
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        const DistanceConstraint& c = constraints[i];
+        const double stretch = c.point_a.distance_to(c.point_b) - c.length;
+
+        rhs_values[i] = stretch;
+        candidate[i] = stretch > -TAUT_TOLERANCE * c.length && directions[i].magnitude_squared() > 0.0;
+        active[i] = candidate[i] && stretch > 0.0;
+    }
+
+    solve_active(rhs_values, true);
+}
+
+void DistanceConstraintSolver::solve_velocities()
+{
+    compute_jacobians();
+
+    // Activate each taut constraint that is still stretching, using the separating velocity as the amount to remove
+    const size_t count = constraints.size();
+    rhs_values.resize(count);
+    active.assign(count, false);
+    candidate.assign(count, false);
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        const DistanceConstraint& c = constraints[i];
+        const double stretch = c.point_a.distance_to(c.point_b) - c.length;
+
+        const double separating_vel =
+            (c.body_b->get_velocity() - c.body_a->get_velocity()).dot(directions[i]) +
+            c.body_b->get_rotational_velocity() * arms_b[i] -
+            c.body_a->get_rotational_velocity() * arms_a[i];
+
+        rhs_values[i] = separating_vel;
+        candidate[i] = stretch > -TAUT_TOLERANCE * c.length && directions[i].magnitude_squared() > 0.0;
+        active[i] = candidate[i] && separating_vel > 0.0;
+    }
+
+    solve_active(rhs_values, false);
+}
+
+void DistanceConstraintSolver::compute_jacobians()
+{
+    const size_t count = constraints.size();
+
+    directions.resize(count);
+    offsets_a.resize(count);
+    offsets_b.resize(count);
+    arms_a.resize(count);
+    arms_b.resize(count);
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        const DistanceConstraint& c = constraints[i];
+
+        const Vector2 delta = c.point_b - c.point_a;
+        const double length = delta.magnitude();
+
+        directions[i] = (length > 0.0) ? delta / length : Vector2();
+        offsets_a[i] = c.point_a - c.body_a->get_position();
+        offsets_b[i] = c.point_b - c.body_b->get_position();
+        arms_a[i] = offsets_a[i].cross(directions[i]);
+        arms_b[i] = offsets_b[i].cross(directions[i]);
+    }
+}
+
+double DistanceConstraintSolver::effective_mass(
+    const size_t i,
+    const size_t j) const
+{
+    const PhysicsBody* const bodies_i[2] = { constraints[i].body_a, constraints[i].body_b };
+    const PhysicsBody* const bodies_j[2] = { constraints[j].body_a, constraints[j].body_b };
+
+    const double arms_i[2] = { -arms_a[i], arms_b[i] };
+    const double arms_j[2] = { -arms_a[j], arms_b[j] };
+    const double signs[2] = { -1.0, 1.0 };
+
+    // Sum the coupling through each body shared by the two constraints
+    double k = 0.0;
+    for (size_t a = 0; a < 2; ++a)
+    {
+        for (size_t b = 0; b < 2; ++b)
+        {
+            if (bodies_i[a] == bodies_j[b])
+            {
+                k += signs[a] * signs[b] * directions[i].dot(directions[j]) / bodies_i[a]->get_mass();
+                k += arms_i[a] * arms_j[b] / bodies_i[a]->get_inertia();
+            }
+        }
+    }
+
+    return k;
+}
+
+void DistanceConstraintSolver::solve_active(
+    const std::vector<double>& rhs,
+    const bool position)
+{
+    // Limit the active set changes so that a degenerate configuration cannot cycle forever
+    const size_t max_iterations = 4 * constraints.size() + 4;
+    bool solved = false;
+
+    for (size_t iteration = 0; iteration < max_iterations; ++iteration)
+    {
+        // Collect the active constraints
+        active_indices.clear();
+        for (size_t i = 0; i < constraints.size(); ++i)
+        {
+            if (active[i])
+            {
+                active_indices.push_back(i);
+            }
+        }
+
+        const size_t n = active_indices.size();
+
+        // Build the effective mass matrix and right-hand side
+        matrix.resize(n * n);
+        lambda.resize(n);
+
+        for (size_t r = 0; r < n; ++r)
+        {
+            for (size_t c = 0; c < n; ++c)
+            {
+                matrix[r * n + c] = effective_mass(active_indices[r], active_indices[c]);
+            }
+
+            lambda[r] = rhs[active_indices[r]];
+        }
+
+        // Solve with Gaussian elimination and partial pivoting
+        bool singular = false;
+        for (size_t col = 0; col < n && !singular; ++col)
+        {
+            size_t pivot = col;
+            for (size_t r = col + 1; r < n; ++r)
+            {
+                if (std::abs(matrix[r * n + col]) > std::abs(matrix[pivot * n + col]))
+                {
+                    pivot = r;
+                }
+            }
+
+            if (std::abs(matrix[pivot * n + col]) < 1e-12)
+            {
+                // Drop the degenerate constraint and try again without it
+                active[active_indices[col]] = false;
+                singular = true;
+                break;
+            }
+
+            if (pivot != col)
+            {
+                for (size_t c = 0; c < n; ++c)
+                {
+                    std::swap(matrix[col * n + c], matrix[pivot * n + c]);
+                }
+                std::swap(lambda[col], lambda[pivot]);
+            }
+
+            for (size_t r = col + 1; r < n; ++r)
+            {
+                const double factor = matrix[r * n + col] / matrix[col * n + col];
+                for (size_t c = col; c < n; ++c)
+                {
+                    matrix[r * n + c] -= factor * matrix[col * n + c];
+                }
+                lambda[r] -= factor * lambda[col];
+            }
+        }
+
+        if (singular)
+        {
+            continue;
+        }
+
+        for (size_t r = n; r-- > 0;)
+        {
+            for (size_t c = r + 1; c < n; ++c)
+            {
+                lambda[r] -= matrix[r * n + c] * lambda[c];
+            }
+            lambda[r] /= matrix[r * n + r];
+        }
+
+        // Remove the constraint that would push the hardest and try again, since ropes can only pull
+        size_t most_negative = n;
+        for (size_t r = 0; r < n; ++r)
+        {
+            if (lambda[r] < 0.0 && (most_negative == n || lambda[r] < lambda[most_negative]))
+            {
+                most_negative = r;
+            }
+        }
+
+        if (most_negative < n)
+        {
+            active[active_indices[most_negative]] = false;
+            continue;
+        }
+
+        // Add the candidate constraint that would be stretched the most by the impulses found, if any
+        size_t most_violated = constraints.size();
+        double max_violation = 1e-9;
+        for (size_t i = 0; i < constraints.size(); ++i)
+        {
+            if (!candidate[i] || active[i])
+            {
+                continue;
+            }
+
+            double remaining = rhs[i];
+            for (size_t r = 0; r < n; ++r)
+            {
+                remaining -= effective_mass(i, active_indices[r]) * lambda[r];
+            }
+
+            if (remaining > max_violation)
+            {
+                max_violation = remaining;
+                most_violated = i;
+            }
+        }
+
+        if (most_violated < constraints.size())
+        {
+            active[most_violated] = true;
+            continue;
+        }
+
+        solved = true;
+        break;
+    }
+
+    if (!solved)
+    {
+        return;
+    }
+
+    // Apply the resulting impulses, pulling the anchor points of each constraint together
+    for (size_t r = 0; r < active_indices.size(); ++r)
+    {
+        const size_t i = active_indices[r];
+        const Vector2 impulse = directions[i] * lambda[r];
+
+        if (position)
+        {
+            constraints[i].body_a->apply_position_impulse(impulse, offsets_a[i]);
+            constraints[i].body_b->apply_position_impulse(-impulse, offsets_b[i]);
+        }
+        else
+        {
+            constraints[i].body_a->apply_impulse(impulse, offsets_a[i]);
+            constraints[i].body_b->apply_impulse(-impulse, offsets_b[i]);
+        }
+    }
+}
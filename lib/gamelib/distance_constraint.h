@@ -0,0 +1,101 @@
+#ifndef GIO_DISTANCE_CONSTRAINT_H
+#define GIO_DISTANCE_CONSTRAINT_H
+
+#include <gamelib/physics_object.h>
+#include <gamelib/vector2.h>
+
+#include <cstddef>
+#include <vector>
+
+/**
+ * @brief Limits the distance between two anchor points on two physics bodies to a maximum length,
+ * acting like a rope that can only pull the bodies together
+ */
+struct DistanceConstraint
+{
+    PhysicsBody* body_a = nullptr;
+    PhysicsBody* body_b = nullptr;
+
+    Vector2 point_a;
+    Vector2 point_b;
+
+    double length = 0.0;
+};
+
+/**
+ * @brief Solves a small group of distance constraints together. The coupled effective mass matrix of the
+ * active constraints is solved directly, so that constraints sharing a body converge in a single pass even
+ * when the body responds to each constraint mostly through rotation. Constraints that would need to push
+ * are removed from the active set and the remaining constraints are solved again
+ */
+class DistanceConstraintSolver
+{
+public:
+    /**
+     * @brief constructs an empty solver
+     */
+    DistanceConstraintSolver();
+
+    /**
+     * @brief removes all constraints from the solver
+     */
+    void clear();
+
+    /**
+     * @brief adds a constraint to be solved
+     * @param constraint the constraint to add
+     */
+    void add(const DistanceConstraint& constraint);
+
+    /**
+     * @brief moves and rotates the bodies so that every stretched constraint is returned to its length
+     */
+    void solve_positions();
+
+    /**
+     * @brief applies impulses so that no constraint at its length continues to stretch
+     */
+    void solve_velocities();
+
+protected:
+    /**
+     * @brief computes the direction and Jacobian terms for each constraint from the current anchor points
+     */
+    void compute_jacobians();
+
+    /**
+     * @brief solves K * lambda = rhs for the constraints flagged as active, clearing the flag of any
+     * constraint that would need a negative lambda and activating any candidate constraint left
+     * violated, and applies the resulting impulses
+     * @param rhs the amount to remove from each constraint, as a stretch or separating velocity
+     * @param position if true, applies position impulses, otherwise applies velocity impulses
+     */
+    void solve_active(
+        const std::vector<double>& rhs,
+        const bool position);
+
+    /**
+     * @brief computes the effective mass coupling between two constraints
+     */
+    double effective_mass(
+        const size_t i,
+        const size_t j) const;
+
+protected:
+    std::vector<DistanceConstraint> constraints;
+
+    std::vector<Vector2> directions;
+    std::vector<Vector2> offsets_a;
+    std::vector<Vector2> offsets_b;
+    std::vector<double> arms_a;
+    std::vector<double> arms_b;
+
+    std::vector<bool> candidate;
+    std::vector<bool> active;
+    std::vector<size_t> active_indices;
+    std::vector<double> matrix;
+    std::vector<double> lambda;
+    std::vector<double> rhs_values;
+};
+
+#endif // GIO_DISTANCE_CONSTRAINT_H
@@ -4,7 +4,9 @@
 #include <gamelib/vector2.h>
 #include <gamelib/input_manager.h>
 
-#include <allegro5/display.h>
+#include <cstddef>
+
+struct ALLEGRO_DISPLAY;
 
 /**
  * @brief a basic drawing state to use when drawing
@@ -16,6 +18,12 @@ struct DrawState
     InputManager* input_manager = nullptr;
     size_t screen_w = 0;
     size_t screen_h = 0;
+
+    /**
+     * @brief the fraction of a physics period elapsed since the newest physics state, used to draw
+     * between the previous state at 0 and the newest state at 1
+     */
+    double interpolation_alpha = 1.0;
 };
 
 /**
@@ -0,0 +1,83 @@
+#include <gamelib/fixed_step_accumulator.h>
+
+#include <algorithm>
+#include <cmath>
+
+FixedStepAccumulator::FixedStepAccumulator(
+    const double time_step,
+    const size_t max_steps) :
+    time_step(time_step),
+    max_steps(max_steps),
+    pending_time(0.0),
+    dropped_time(0.0),
+    limited_frame_count(0)
+{
+    // Empty Constructor
+}
+
+size_t FixedStepAccumulator::advance(const double dt)
+{
+    // Ignore time running backwards, which only a faulty clock would report
+    const double available = pending_time + std::max(dt, 0.0);
+
+    size_t steps = static_cast<size_t>(std::floor(available / time_step));
+    pending_time = available - static_cast<double>(steps) * time_step;
+
+    // Guard against rounding leaving a full step behind, or a tiny negative remainder
+    if (pending_time >= time_step)
+    {
+        pending_time -= time_step;
+        ++steps;
+    }
+    else if (pending_time < 0.0)
+    {
+        pending_time = 0.0;
+    }
+
+    // Drop any steps beyond the budget instead of deferring them to later frames
+    if (max_steps > 0 && steps > max_steps)
+    {
+        dropped_time += static_cast<double>(steps - max_steps) * time_step;
+        ++limited_frame_count;
+        steps = max_steps;
+    }
+
+    return steps;
+}
+
+void FixedStepAccumulator::reset()
+{
+    pending_time = 0.0;
+    dropped_time = 0.0;
+    limited_frame_count = 0;
+}
+
+double FixedStepAccumulator::get_time_step() const
+{
+    return time_step;
+}
+
+void FixedStepAccumulator::set_max_steps(const size_t max_steps)
+{
+    this->max_steps = max_steps;
+}
+
+size_t FixedStepAccumulator::get_max_steps() const
+{
+    return max_steps;
+}
+
+double FixedStepAccumulator::get_pending_time() const
+{
+    return pending_time;
+}
+
+double FixedStepAccumulator::get_dropped_time() const
+{
+    return dropped_time;
+}
+
+size_t FixedStepAccumulator::get_limited_frame_count() const
+{
+    return limited_frame_count;
+}
@@ -0,0 +1,75 @@
+#ifndef GIO_FIXED_STEP_ACCUMULATOR_H
+#define GIO_FIXED_STEP_ACCUMULATOR_H
+
+#include <cstddef>
+
+/**
+ * @brief Converts elapsed frame time into a whole number of fixed time steps. Any time left over that
+ * is shorter than a step is carried into the next frame, so that simulated time keeps pace with the
+ * elapsed time instead of losing the remainder each frame. The steps run for a single frame are limited
+ * to a budget, so that a late frame cannot demand more steps than can be run in time; the time beyond
+ * the budget is dropped and counted rather than carried, so that the simulation does not fall further
+ * behind with each frame
+ */
+class FixedStepAccumulator
+{
+public:
+    /**
+     * @brief constructs an empty accumulator
+     * @param time_step the fixed time step, in seconds
+     * @param max_steps the most steps to run for a single frame, or 0 for no limit
+     */
+    FixedStepAccumulator(
+        const double time_step,
+        const size_t max_steps);
+
+    /**
+     * @brief adds the time elapsed since the previous frame
+     * @param dt the elapsed time, in seconds
+     * @return the number of time steps to run for this frame
+     */
+    size_t advance(const double dt);
+
+    /**
+     * @brief clears the carried time and the dropped time metrics
+     */
+    void reset();
+
+    double get_time_step() const;
+
+    /**
+     * @brief sets the most steps to run for a single frame
+     * @param max_steps the step budget, or 0 for no limit
+     */
+    void set_max_steps(const size_t max_steps);
+
+    size_t get_max_steps() const;
+
+    /**
+     * @brief provides the time carried into the next frame, which is always shorter than a time step
+     * @return the carried time, in seconds
+     */
+    double get_pending_time() const;
+
+    /**
+     * @brief provides the total time dropped because frames needed more steps than the budget allows
+     * @return the dropped time, in seconds
+     */
+    double get_dropped_time() const;
+
+    /**
+     * @brief provides the number of frames that needed more steps than the budget allows
+     * @return the frame count
+     */
+    size_t get_limited_frame_count() const;
+
+protected:
+    double time_step;
+    size_t max_steps;
+
+    double pending_time;
+    double dropped_time;
+    size_t limited_frame_count;
+};
+
+#endif // GIO_FIXED_STEP_ACCUMULATOR_H
@@ -6,8 +6,10 @@
 
 /**
  * @brief a basic game object that contains both a step and a draw action
+ * @tparam StateType the step state type passed to each step function
 */
-class GameObject : public StepObject, public DrawObject
+template <typename StateType>
+class GameObject : public StepObject<StateType>, public DrawObject
 {
 
 };
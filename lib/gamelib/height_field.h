@@ -0,0 +1,53 @@
+#ifndef GIO_HEIGHT_FIELD_H
+#define GIO_HEIGHT_FIELD_H
+
+#include <gamelib/span.h>
+#include <gamelib/vector2.h>
+
+/**
+ * @brief An interface for a ground surface given as a height for every x location, where larger y
+ * values are further below the surface. The surface is linear between sample points a fixed distance
+ * apart, so that the surface is the polyline through the sample points
+ */
+class HeightField
+{
+public:
+    /**
+     * @brief samples the surface at several locations in one call. An output span is either empty
+     * or holds a value for every location
+     * @param xs the x locations to sample
+     * @param heights set to the surface y coordinate at each location, or empty to skip
+     * @param normals set to the unit surface normal at each location, or empty to skip
+     */
+    virtual void sample(
+        gio::Span<const double> xs,
+        gio::Span<double> heights,
+        gio::Span<Vector2> normals) = 0;
+
+    /**
+     * @brief finds the highest point of the surface between two x locations, which may be
+     * conservatively higher than the true highest point
+     * @param x_min the smallest x location
+     * @param x_max the largest x location
+     * @return the smallest surface y coordinate in the range
+     */
+    virtual double highest_point_between(
+        const double x_min,
+        const double x_max) = 0;
+
+    /**
+     * @brief provides the distance between the sample points of the surface
+     * @return the sample spacing
+     */
+    virtual double get_sample_spacing() const = 0;
+
+    /**
+     * @brief virtual destructor
+     */
+    virtual ~HeightField()
+    {
+        // Empty Destructor
+    }
+};
+
+#endif // GIO_HEIGHT_FIELD_H
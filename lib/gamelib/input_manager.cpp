@@ -1,6 +1,6 @@
 #include <gamelib/input_manager.h>
 
-#include <allegro5/keycodes.h>
+#include <gamelib/keycodes.h>
 
 InputManager::InputManager()
 {
@@ -40,6 +40,19 @@ bool InputManager::get_key_rising_edge(const int keycode)
     return val;
 }
 
+InputSnapshot InputManager::take_snapshot()
+{
+    InputSnapshot snapshot;
+
+    for (auto& it : status_map)
+    {
+        snapshot.set_key_state(it.first, it.second.press_status, it.second.rising_edge);
+        it.second.rising_edge = false;
+    }
+
+    return snapshot;
+}
+
 bool InputManager::get_dir_up() const
 {
     return get_key_status(ALLEGRO_KEY_UP) || get_key_status(ALLEGRO_KEY_W);
@@ -1,6 +1,8 @@
 #ifndef GIO_INPUT_MANAGER_H
 #define GIO_INPUT_MANAGER_H
 
+#include <gamelib/input_snapshot.h>
+
 #include <unordered_map>
 
 /**
@@ -42,6 +44,13 @@ public:
     */
     bool get_key_rising_edge(const int keycode);
 
+    /**
+     * @brief provides the current key state frozen for a physics tick, consuming every rising edge
+     * so that each one is delivered to a single tick
+     * @return the key state snapshot
+     */
+    InputSnapshot take_snapshot();
+
     /**
      * @brief determines if the up direction is pressed
      * @return true if up is pressed
@@ -0,0 +1,380 @@
+#include <gamelib/input_recording.h>
+
+#include <cstring>
+
+namespace
+{
+    /**
+     * @brief identifies the start of a recording and its format version
+     */
+    const char RECORDING_MAGIC[4] = { 'G', 'I', 'O', 'R' };
+    const uint8_t RECORDING_VERSION = 1;
+
+    /**
+     * @brief identifies each record within the body of a recording
+     */
+    const uint8_t RECORD_END = 0;
+    const uint8_t RECORD_RUN = 1;
+    const uint8_t RECORD_CHECKPOINT = 2;
+
+    /**
+     * @brief the maximum number of keys, with two bits for each key in a 32-bit mask
+     */
+    const size_t MAX_KEYS = 16;
+
+    /**
+     * @brief the largest metadata block accepted when reading, to reject corrupt lengths
+     */
+    const uint64_t MAX_METADATA_SIZE = 1 << 20;
+}
+
+namespace gio
+{
+    void write_varint(
+        std::ostream& out,
+        uint64_t value)
+    {
+        while (value >= 0x80)
+        {
+            out.put(static_cast<char>((value & 0x7F) | 0x80));
+            value >>= 7;
+        }
+        out.put(static_cast<char>(value));
+    }
+
+    bool read_varint(
+        std::istream& in,
+        uint64_t& value)
+    {
+        value = 0;
+        for (unsigned int shift = 0; shift < 64; shift += 7)
+        {
+            const int c = in.get();
+            if (c == std::char_traits<char>::eof())
+            {
+                return false;
+            }
+
+            value |= static_cast<uint64_t>(c & 0x7F) << shift;
+            if ((c & 0x80) == 0)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void write_double(
+        std::ostream& out,
+        const double value)
+    {
+        uint64_t bits = 0;
+        std::memcpy(&bits, &value, sizeof(bits));
+
+        for (size_t i = 0; i < sizeof(bits); ++i)
+        {
+            out.put(static_cast<char>((bits >> (8 * i)) & 0xFF));
+        }
+    }
+
+    bool read_double(
+        std::istream& in,
+        double& value)
+    {
+        uint64_t bits = 0;
+        for (size_t i = 0; i < sizeof(bits); ++i)
+        {
+            const int c = in.get();
+            if (c == std::char_traits<char>::eof())
+            {
+                return false;
+            }
+            bits |= static_cast<uint64_t>(c & 0xFF) << (8 * i);
+        }
+
+        std::memcpy(&value, &bits, sizeof(value));
+        return true;
+    }
+}
+
+InputRecorder::InputRecorder(
+    std::ostream& out,
+    const std::vector<int>& keycodes,
+    const std::string& metadata) :
+    out(out),
+    keycodes(keycodes),
+    run_mask(0),
+    run_length(0),
+    step_count(0),
+    finished(false)
+{
+    // Only record the supported number of keys
+    if (this->keycodes.size() > MAX_KEYS)
+    {
+        this->keycodes.resize(MAX_KEYS);
+    }
+
+    // Write the header, including the recorded keys so that a replay does not depend on the key order
+    out.write(RECORDING_MAGIC, sizeof(RECORDING_MAGIC));
+    out.put(static_cast<char>(RECORDING_VERSION));
+
+    gio::write_varint(out, this->keycodes.size());
+    for (const int keycode : this->keycodes)
+    {
+        gio::write_varint(out, static_cast<uint64_t>(keycode));
+    }
+
+    gio::write_varint(out, metadata.size());
+    out.write(metadata.data(), static_cast<std::streamsize>(metadata.size()));
+}
+
+InputRecorder::~InputRecorder()
+{
+    finish();
+}
+
+void InputRecorder::record_step(const InputSnapshot& input)
+{
+    if (finished)
+    {
+        return;
+    }
+
+    // Build the mask for this step, with the pressed and rising edge bits of each key side by side
+    uint32_t mask = 0;
+    for (size_t i = 0; i < keycodes.size(); ++i)
+    {
+        if (input.get_key_status(keycodes[i]))
+        {
+            mask |= 1u << (2 * i);
+        }
+        if (input.get_key_rising_edge(keycodes[i]))
+        {
+            mask |= 1u << (2 * i + 1);
+        }
+    }
+
+    // Extend the current run, or start a new one if the state has changed
+    if (run_length > 0 && mask != run_mask)
+    {
+        flush_run();
+    }
+
+    run_mask = mask;
+    ++run_length;
+    ++step_count;
+}
+
+void InputRecorder::record_checkpoint(const uint64_t value)
+{
+    if (finished)
+    {
+        return;
+    }
+
+    flush_run();
+
+    out.put(static_cast<char>(RECORD_CHECKPOINT));
+    for (size_t i = 0; i < sizeof(value); ++i)
+    {
+        out.put(static_cast<char>((value >> (8 * i)) & 0xFF));
+    }
+}
+
+void InputRecorder::finish()
+{
+    if (finished)
+    {
+        return;
+    }
+
+    flush_run();
+
+    out.put(static_cast<char>(RECORD_END));
+    gio::write_varint(out, step_count);
+    out.flush();
+
+    finished = true;
+}
+
+uint64_t InputRecorder::get_step_count() const
+{
+    return step_count;
+}
+
+void InputRecorder::flush_run()
+{
+    if (run_length == 0)
+    {
+        return;
+    }
+
+    out.put(static_cast<char>(RECORD_RUN));
+    gio::write_varint(out, run_mask);
+    gio::write_varint(out, run_length);
+
+    run_length = 0;
+}
+
+InputRecording::InputRecording() :
+    step_count(0),
+    play_run(0),
+    play_offset(0)
+{
+    // Empty Constructor
+}
+
+bool InputRecording::read(std::istream& in)
+{
+    metadata.clear();
+    keycodes.clear();
+    runs.clear();
+    checkpoints.clear();
+    step_count = 0;
+    rewind();
+
+    // Check the header
+    char magic[sizeof(RECORDING_MAGIC)];
+    if (!in.read(magic, sizeof(magic)) || std::memcmp(magic, RECORDING_MAGIC, sizeof(magic)) != 0)
+    {
+        return false;
+    }
+
+    if (in.get() != RECORDING_VERSION)
+    {
+        return false;
+    }
+
+    uint64_t key_count = 0;
+    if (!gio::read_varint(in, key_count) || key_count > MAX_KEYS)
+    {
+        return false;
+    }
+
+    for (uint64_t i = 0; i < key_count; ++i)
+    {
+        uint64_t keycode = 0;
+        if (!gio::read_varint(in, keycode))
+        {
+            return false;
+        }
+        keycodes.push_back(static_cast<int>(keycode));
+    }
+
+    uint64_t metadata_size = 0;
+    if (!gio::read_varint(in, metadata_size) || metadata_size > MAX_METADATA_SIZE)
+    {
+        return false;
+    }
+
+    metadata.resize(static_cast<size_t>(metadata_size));
+    if (!in.read(&metadata[0], static_cast<std::streamsize>(metadata_size)))
+    {
+        return false;
+    }
+
+    // Read each record until the end marker
+    while (true)
+    {
+        const int tag = in.get();
+
+        if (tag == RECORD_RUN)
+        {
+            uint64_t mask = 0;
+            Run run;
+
+            if (!gio::read_varint(in, mask) || !gio::read_varint(in, run.length) || run.length == 0)
+            {
+                return false;
+            }
+
+            run.mask = static_cast<uint32_t>(mask);
+            runs.push_back(run);
+            step_count += run.length;
+        }
+        else if (tag == RECORD_CHECKPOINT)
+        {
+            Checkpoint checkpoint;
+            checkpoint.step_index = step_count;
+            checkpoint.value = 0;
+
+            for (size_t i = 0; i < sizeof(checkpoint.value); ++i)
+            {
+                const int c = in.get();
+                if (c == std::char_traits<char>::eof())
+                {
+                    return false;
+                }
+                checkpoint.value |= static_cast<uint64_t>(c & 0xFF) << (8 * i);
+            }
+
+            checkpoints.push_back(checkpoint);
+        }
+        else if (tag == RECORD_END)
+        {
+            // Check that the recorded step count matches the runs read
+            uint64_t recorded_steps = 0;
+            return gio::read_varint(in, recorded_steps) && recorded_steps == step_count;
+        }
+        else
+        {
+            return false;
+        }
+    }
+}
+
+const std::string& InputRecording::get_metadata() const
+{
+    return metadata;
+}
+
+const std::vector<int>& InputRecording::get_keycodes() const
+{
+    return keycodes;
+}
+
+const std::vector<InputRecording::Checkpoint>& InputRecording::get_checkpoints() const
+{
+    return checkpoints;
+}
+
+uint64_t InputRecording::get_step_count() const
+{
+    return step_count;
+}
+
+void InputRecording::rewind()
+{
+    play_run = 0;
+    play_offset = 0;
+}
+
+bool InputRecording::has_next_step() const
+{
+    return play_run < runs.size();
+}
+
+void InputRecording::play_step(InputSnapshot& input)
+{
+    if (!has_next_step())
+    {
+        return;
+    }
+
+    // Apply the recorded state of each key
+    const uint32_t mask = runs[play_run].mask;
+    for (size_t i = 0; i < keycodes.size(); ++i)
+    {
+        input.set_key_state(
+            keycodes[i],
+            (mask & (1u << (2 * i))) != 0,
+            (mask & (1u << (2 * i + 1))) != 0);
+    }
+
+    // Advance to the next step
+    if (++play_offset >= runs[play_run].length)
+    {
+        ++play_run;
+        play_offset = 0;
+    }
+}
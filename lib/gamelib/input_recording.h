@@ -0,0 +1,199 @@
+#ifndef GIO_INPUT_RECORDING_H
+#define GIO_INPUT_RECORDING_H
+
+#include <gamelib/input_snapshot.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace gio
+{
+    /**
+     * @brief writes an unsigned value as a little-endian base-128 variable length integer
+     * @param out the stream to write to
+     * @param value the value to write
+     */
+    void write_varint(
+        std::ostream& out,
+        uint64_t value);
+
+    /**
+     * @brief reads an unsigned variable length integer written by write_varint
+     * @param in the stream to read from
+     * @param value set to the value read
+     * @return true if a complete value was read
+     */
+    bool read_varint(
+        std::istream& in,
+        uint64_t& value);
+
+    /**
+     * @brief writes the exact bits of a double in little-endian byte order
+     * @param out the stream to write to
+     * @param value the value to write
+     */
+    void write_double(
+        std::ostream& out,
+        const double value);
+
+    /**
+     * @brief reads a double written by write_double
+     * @param in the stream to read from
+     * @param value set to the value read
+     * @return true if a complete value was read
+     */
+    bool read_double(
+        std::istream& in,
+        double& value);
+}
+
+/**
+ * @brief Records the state of a fixed set of keys once per physics step to a compact binary stream.
+ * Each step is stored as a bit mask of the pressed and rising-edge state of each key, and repeated
+ * masks are run-length encoded, so that a held key costs only a few bytes no matter how many steps
+ * it is held for. Checkpoint values, such as a hash of the simulation state, can be interleaved
+ * with the steps so that a replay can detect exactly where it diverges
+ */
+class InputRecorder
+{
+public:
+    /**
+     * @brief writes the recording header to the stream
+     * @param out the stream to write to, which must outlive the recorder
+     * @param keycodes the keys to record, at most 16
+     * @param metadata application data to store in the header, such as the simulation settings
+     */
+    InputRecorder(
+        std::ostream& out,
+        const std::vector<int>& keycodes,
+        const std::string& metadata);
+
+    /**
+     * @brief finishes the recording if it has not already been finished
+     */
+    ~InputRecorder();
+
+    InputRecorder(const InputRecorder&) = delete;
+    InputRecorder& operator=(const InputRecorder&) = delete;
+
+    /**
+     * @brief records the key state to be used for the next physics step. Must be called before the
+     * step runs
+     * @param input the input snapshot that the step will read
+     */
+    void record_step(const InputSnapshot& input);
+
+    /**
+     * @brief records a checkpoint value after the steps recorded so far
+     * @param value the checkpoint value
+     */
+    void record_checkpoint(const uint64_t value);
+
+    /**
+     * @brief writes any pending steps and the end marker, and flushes the stream
+     */
+    void finish();
+
+    /**
+     * @brief provides the number of steps recorded so far
+     * @return the step count
+     */
+    uint64_t get_step_count() const;
+
+protected:
+    /**
+     * @brief writes the pending run of identical steps, if any
+     */
+    void flush_run();
+
+protected:
+    std::ostream& out;
+    std::vector<int> keycodes;
+
+    uint32_t run_mask;
+    uint64_t run_length;
+    uint64_t step_count;
+
+    bool finished;
+};
+
+/**
+ * @brief Provides the contents of a recording made by InputRecorder, and plays the recorded key
+ * state back into an input snapshot one step at a time
+ */
+class InputRecording
+{
+public:
+    /**
+     * @brief a checkpoint value and the number of steps recorded before it
+     */
+    struct Checkpoint
+    {
+        uint64_t step_index;
+        uint64_t value;
+    };
+
+    /**
+     * @brief constructs an empty recording
+     */
+    InputRecording();
+
+    /**
+     * @brief reads a complete recording from a stream, replacing the current contents
+     * @param in the stream to read from
+     * @return true if a complete and valid recording was read
+     */
+    bool read(std::istream& in);
+
+    const std::string& get_metadata() const;
+
+    const std::vector<int>& get_keycodes() const;
+
+    const std::vector<Checkpoint>& get_checkpoints() const;
+
+    uint64_t get_step_count() const;
+
+    /**
+     * @brief restarts playback from the first step
+     */
+    void rewind();
+
+    /**
+     * @brief determines if any recorded steps remain to be played
+     * @return true if playback has not reached the end
+     */
+    bool has_next_step() const;
+
+    /**
+     * @brief sets the state of each recorded key in the input snapshot to the state recorded for the
+     * next step, and advances playback by one step
+     * @param input the input snapshot to update
+     */
+    void play_step(InputSnapshot& input);
+
+protected:
+    /**
+     * @brief a run of identical recorded steps
+     */
+    struct Run
+    {
+        uint32_t mask;
+        uint64_t length;
+    };
+
+protected:
+    std::string metadata;
+    std::vector<int> keycodes;
+    std::vector<Run> runs;
+    std::vector<Checkpoint> checkpoints;
+    uint64_t step_count;
+
+    size_t play_run;
+    uint64_t play_offset;
+};
+
+#endif // GIO_INPUT_RECORDING_H
@@ -0,0 +1,58 @@
+#include <gamelib/input_snapshot.h>
+
+InputSnapshot::InputSnapshot()
+{
+    // Empty Constructor
+}
+
+bool InputSnapshot::get_key_status(const int keycode) const
+{
+    return valid_keycode(keycode) && pressed_keys[static_cast<size_t>(keycode)];
+}
+
+bool InputSnapshot::get_key_rising_edge(const int keycode) const
+{
+    return valid_keycode(keycode) && rising_edges[static_cast<size_t>(keycode)];
+}
+
+void InputSnapshot::set_key_state(
+    const int keycode,
+    const bool pressed,
+    const bool rising_edge)
+{
+    if (valid_keycode(keycode))
+    {
+        pressed_keys[static_cast<size_t>(keycode)] = pressed;
+        rising_edges[static_cast<size_t>(keycode)] = rising_edge;
+    }
+}
+
+void InputSnapshot::clear_rising_edges()
+{
+    rising_edges.reset();
+}
+
+bool InputSnapshot::get_dir_up() const
+{
+    return pressed_keys[ALLEGRO_KEY_UP] || pressed_keys[ALLEGRO_KEY_W];
+}
+
+bool InputSnapshot::get_dir_down() const
+{
+    return pressed_keys[ALLEGRO_KEY_DOWN] || pressed_keys[ALLEGRO_KEY_S];
+}
+
+bool InputSnapshot::get_dir_left() const
+{
+    return pressed_keys[ALLEGRO_KEY_LEFT] || pressed_keys[ALLEGRO_KEY_A];
+}
+
+bool InputSnapshot::get_dir_right() const
+{
+    return pressed_keys[ALLEGRO_KEY_RIGHT] || pressed_keys[ALLEGRO_KEY_D];
+}
+
+bool InputSnapshot::valid_keycode(const int keycode)
+{
+    return keycode >= 0 && keycode < ALLEGRO_KEY_MAX;
+}
@@ -0,0 +1,89 @@
+#ifndef GIO_INPUT_SNAPSHOT_H
+#define GIO_INPUT_SNAPSHOT_H
+
+#include <gamelib/keycodes.h>
+
+#include <bitset>
+
+/**
+ * @brief Provides the key state frozen for a single physics tick, taken from an InputManager once
+ * before the substeps run. The pressed keys and rising edges are held in bitsets indexed by keycode,
+ * so that each substep reads them without hashing or changing any state
+ */
+class InputSnapshot
+{
+public:
+    /**
+     * @brief constructs a snapshot with no keys pressed
+     */
+    InputSnapshot();
+
+    /**
+     * @brief determines the state of a given key
+     * @param keycode the keycode to check
+     * @return true if the key state is pressed
+     */
+    bool get_key_status(const int keycode) const;
+
+    /**
+     * @brief determines if the given key was newly pressed for this tick. Unlike the input manager,
+     * reading the rising edge does not reset it, so every reader within the tick sees the same edge
+     * @param keycode the keycode to check
+     * @return true if the key has a rising edge
+     */
+    bool get_key_rising_edge(const int keycode) const;
+
+    /**
+     * @brief sets both the pressed state and the rising edge state of a key directly, ignoring any
+     * keycode outside of the Allegro key range
+     * @param keycode the keycode to set
+     * @param pressed true if the key is pressed
+     * @param rising_edge true if the key has a rising edge
+     */
+    void set_key_state(
+        const int keycode,
+        const bool pressed,
+        const bool rising_edge);
+
+    /**
+     * @brief clears every rising edge, to be called after the first substep of a tick so that each
+     * edge is only delivered once
+     */
+    void clear_rising_edges();
+
+    /**
+     * @brief determines if the up direction is pressed
+     * @return true if up is pressed
+     */
+    bool get_dir_up() const;
+
+    /**
+     * @brief determines if the down direction is pressed
+     * @return true if down is pressed
+     */
+    bool get_dir_down() const;
+
+    /**
+     * @brief determines if the left direction is pressed
+     * @return true if left is pressed
+     */
+    bool get_dir_left() const;
+
+    /**
+     * @brief determines if the right direction is pressed
+     * @return true if right is pressed
+     */
+    bool get_dir_right() const;
+
+protected:
+    /**
+     * @brief determines if a keycode can be stored in the key bitsets
+     */
+    static bool valid_keycode(const int keycode);
+
+protected:
+    std::bitset<ALLEGRO_KEY_MAX> pressed_keys;
+    std::bitset<ALLEGRO_KEY_MAX> rising_edges;
+};
+
+#endif // GIO_INPUT_SNAPSHOT_H
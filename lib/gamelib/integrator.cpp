@@ -0,0 +1,412 @@
+#include <gamelib/integrator.h>
+
+#include <gamelib/constants.h>
+#include <gamelib/integrator_kernel.h>
+#include <gamelib/physics_object.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+
+namespace
+{
+    /**
+     * @brief provides the body state fields of the set in the same order as BodyStateArrays::fields
+     */
+    std::array<std::vector<double>*, BodyStateArrays::FIELD_COUNT> state_fields(RigidBodySet& bodies)
+    {
+        return {
+            &bodies.position_x,
+            &bodies.position_y,
+            &bodies.velocity_x,
+            &bodies.velocity_y,
+            &bodies.rotation,
+            &bodies.rotational_vel
+        };
+    }
+
+    /**
+     * @brief provides the body state fields of the set in the same order as BodyStateArrays::fields
+     */
+    std::array<const std::vector<double>*, BodyStateArrays::FIELD_COUNT> state_fields(const RigidBodySet& bodies)
+    {
+        return {
+            &bodies.position_x,
+            &bodies.position_y,
+            &bodies.velocity_x,
+            &bodies.velocity_y,
+            &bodies.rotation,
+            &bodies.rotational_vel
+        };
+    }
+
+    /**
+     * @brief applies half of a velocity Verlet velocity update from the currently accumulated forces
+     */
+    void kick(
+        RigidBodySet& bodies,
+        const PhysicsState& state,
+        const double half_dt)
+    {
+        for (size_t i = 0; i < bodies.size(); ++i)
+        {
+            const double inv_mass = 1.0 / bodies.mass[i];
+
+            bodies.velocity_x[i] += (bodies.force_x[i] * inv_mass + state.gravity.x) * half_dt;
+            bodies.velocity_y[i] += (bodies.force_y[i] * inv_mass + state.gravity.y) * half_dt;
+            bodies.rotational_vel[i] += bodies.moment[i] / bodies.inertia[i] * half_dt;
+        }
+    }
+}
+
+const char* integrator_name(const IntegratorType type)
+{
+    switch (type)
+    {
+    case IntegratorType::SEMI_IMPLICIT_EULER:
+        return "euler";
+    case IntegratorType::VELOCITY_VERLET:
+        return "verlet";
+    case IntegratorType::RK4:
+        return "rk4";
+    case IntegratorType::ADAPTIVE:
+        return "adaptive";
+    }
+
+    return "unknown";
+}
+
+bool integrator_from_name(
+    const char* name,
+    IntegratorType& type)
+{
+    const IntegratorType types[] = {
+        IntegratorType::SEMI_IMPLICIT_EULER,
+        IntegratorType::VELOCITY_VERLET,
+        IntegratorType::RK4,
+        IntegratorType::ADAPTIVE
+    };
+
+    for (const IntegratorType t : types)
+    {
+        if (std::strcmp(name, integrator_name(t)) == 0)
+        {
+            type = t;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void BodyStateArrays::resize(const size_t count)
+{
+    for (auto& field : fields)
+    {
+        field.resize(count);
+    }
+}
+
+std::unique_ptr<Integrator> Integrator::create(const IntegratorType type)
+{
+    switch (type)
+    {
+    case IntegratorType::VELOCITY_VERLET:
+        return std::make_unique<VelocityVerletIntegrator>();
+    case IntegratorType::RK4:
+        return std::make_unique<RK4Integrator>();
+    case IntegratorType::ADAPTIVE:
+        return std::make_unique<AdaptiveIntegrator>();
+    case IntegratorType::SEMI_IMPLICIT_EULER:
+        break;
+    }
+
+    return std::make_unique<SemiImplicitEulerIntegrator>();
+}
+
+Integrator::~Integrator()
+{
+    // Empty Destructor
+}
+
+void Integrator::save_state(
+    const RigidBodySet& bodies,
+    BodyStateArrays& saved)
+{
+    const auto fields = state_fields(bodies);
+    for (size_t j = 0; j < BodyStateArrays::FIELD_COUNT; ++j)
+    {
+        std::copy(fields[j]->begin(), fields[j]->end(), saved.fields[j].begin());
+    }
+}
+
+void Integrator::compute_derivative(
+    const RigidBodySet& bodies,
+    const PhysicsState& state,
+    BodyStateArrays& derivative)
+{
+    for (size_t i = 0; i < bodies.size(); ++i)
+    {
+        const double inv_mass = 1.0 / bodies.mass[i];
+
+        derivative.fields[0][i] = bodies.velocity_x[i];
+        derivative.fields[1][i] = bodies.velocity_y[i];
+        derivative.fields[2][i] = bodies.force_x[i] * inv_mass + state.gravity.x;
+        derivative.fields[3][i] = bodies.force_y[i] * inv_mass + state.gravity.y;
+        derivative.fields[4][i] = bodies.rotational_vel[i];
+        derivative.fields[5][i] = bodies.moment[i] / bodies.inertia[i];
+    }
+}
+
+void Integrator::wrap_rotations(RigidBodySet& bodies)
+{
+    const double two_pi = 2.0 * gio::pi;
+
+    for (double& rotation : bodies.rotation)
+    {
+        rotation -= two_pi * std::floor((rotation + gio::pi) / two_pi);
+    }
+}
+
+IntegratorType SemiImplicitEulerIntegrator::get_type() const
+{
+    return IntegratorType::SEMI_IMPLICIT_EULER;
+}
+
+void SemiImplicitEulerIntegrator::integrate(
+    RigidBodySet& bodies,
+    const PhysicsState& state,
+    const ForceFunction& apply_forces)
+{
+    apply_forces(0.0);
+    gio::integrate_bodies(bodies, state);
+}
+
+IntegratorType VelocityVerletIntegrator::get_type() const
+{
+    return IntegratorType::VELOCITY_VERLET;
+}
+
+void VelocityVerletIntegrator::integrate(
+    RigidBodySet& bodies,
+    const PhysicsState& state,
+    const ForceFunction& apply_forces)
+{
+    const double dt = state.time_step;
+
+    // Kick the velocities by half a step with the starting forces
+    apply_forces(0.0);
+    kick(bodies, state, 0.5 * dt);
+
+    // Drift the positions with the half-step velocities
+    for (size_t i = 0; i < bodies.size(); ++i)
+    {
+        bodies.position_x[i] += bodies.velocity_x[i] * dt;
+        bodies.position_y[i] += bodies.velocity_y[i] * dt;
+        bodies.rotation[i] += bodies.rotational_vel[i] * dt;
+    }
+
+    // Kick the velocities by the remaining half step with the forces at the new positions
+    apply_forces(dt);
+    kick(bodies, state, 0.5 * dt);
+
+    wrap_rotations(bodies);
+}
+
+IntegratorType RK4Integrator::get_type() const
+{
+    return IntegratorType::RK4;
+}
+
+void RK4Integrator::integrate(
+    RigidBodySet& bodies,
+    const PhysicsState& state,
+    const ForceFunction& apply_forces)
+{
+    const double dt = state.time_step;
+    const size_t count = bodies.size();
+    const auto fields = state_fields(bodies);
+
+    // Save the initial state and clear the weighted derivative sum
+    initial.resize(count);
+    derivative.resize(count);
+    weighted_sum.resize(count);
+
+    save_state(bodies, initial);
+
+    for (auto& field : weighted_sum.fields)
+    {
+        std::fill(field.begin(), field.end(), 0.0);
+    }
+
+    // Evaluate each stage, setting up the state for the following stage as each derivative is found
+    const double stage_weights[4] = { 1.0 / 6.0, 2.0 / 6.0, 2.0 / 6.0, 1.0 / 6.0 };
+    const double stage_offsets[4] = { 0.0, 0.5, 0.5, 1.0 };
+    const double next_stage_offsets[4] = { 0.5, 0.5, 1.0, 0.0 };
+
+    for (size_t stage = 0; stage < 4; ++stage)
+    {
+        apply_forces(stage_offsets[stage] * dt);
+        compute_derivative(bodies, state, derivative);
+
+        for (size_t j = 0; j < BodyStateArrays::FIELD_COUNT; ++j)
+        {
+            for (size_t i = 0; i < count; ++i)
+            {
+                weighted_sum.fields[j][i] += stage_weights[stage] * derivative.fields[j][i];
+                (*fields[j])[i] = initial.fields[j][i] + next_stage_offsets[stage] * dt * derivative.fields[j][i];
+            }
+        }
+    }
+
+    // Combine the stages into the final state
+    for (size_t j = 0; j < BodyStateArrays::FIELD_COUNT; ++j)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            (*fields[j])[i] = initial.fields[j][i] + dt * weighted_sum.fields[j][i];
+        }
+    }
+
+    wrap_rotations(bodies);
+}
+
+AdaptiveIntegrator::AdaptiveIntegrator() :
+    sub_step(0.0),
+    last_sub_steps(0)
+{
+    // Empty Constructor
+}
+
+IntegratorType AdaptiveIntegrator::get_type() const
+{
+    return IntegratorType::ADAPTIVE;
+}
+
+void AdaptiveIntegrator::integrate(
+    RigidBodySet& bodies,
+    const PhysicsState& state,
+    const ForceFunction& apply_forces)
+{
+    const double dt = state.time_step;
+    const double min_step = 1e-4 * dt;
+    const double tolerance = state.adaptive_tolerance;
+    const size_t count = bodies.size();
+    const auto fields = state_fields(bodies);
+
+    initial.resize(count);
+    k1.resize(count);
+    k2.resize(count);
+    k3.resize(count);
+    k4.resize(count);
+
+    save_state(bodies, initial);
+
+    // Start from the sub-step size that worked for the previous step, without exceeding the full step
+    if (sub_step <= 0.0 || sub_step > dt)
+    {
+        sub_step = dt;
+    }
+
+    last_sub_steps = 0;
+
+    double time = 0.0;
+    bool k1_valid = false;
+
+    while (dt - time > 1e-12 * dt)
+    {
+        const double h = std::min(sub_step, dt - time);
+        const bool truncated = h < sub_step;
+
+        // Evaluate the stages, reusing the final stage of the last accepted sub-step as the first
+        if (!k1_valid)
+        {
+            apply_forces(time);
+            compute_derivative(bodies, state, k1);
+            k1_valid = true;
+        }
+
+        set_stage_state(bodies, h, 0.5, 0.0, 0.0, 0.0);
+        apply_forces(time + 0.5 * h);
+        compute_derivative(bodies, state, k2);
+
+        set_stage_state(bodies, h, 0.0, 0.75, 0.0, 0.0);
+        apply_forces(time + 0.75 * h);
+        compute_derivative(bodies, state, k3);
+
+        set_stage_state(bodies, h, 2.0 / 9.0, 1.0 / 3.0, 4.0 / 9.0, 0.0);
+        apply_forces(time + h);
+        compute_derivative(bodies, state, k4);
+
+        // Estimate the error from the difference to the embedded second-order solution
+        double error = 0.0;
+        for (size_t j = 0; j < BodyStateArrays::FIELD_COUNT; ++j)
+        {
+            for (size_t i = 0; i < count; ++i)
+            {
+                const double value = (*fields[j])[i];
+                const double low_order = initial.fields[j][i] + h * (
+                    7.0 / 24.0 * k1.fields[j][i] +
+                    0.25 * k2.fields[j][i] +
+                    1.0 / 3.0 * k3.fields[j][i] +
+                    0.125 * k4.fields[j][i]);
+
+                error = std::max(error, std::abs(value - low_order) / (tolerance * (1.0 + std::abs(value))));
+            }
+        }
+
+        const double scale = (error > 0.0) ?
+            std::min(5.0, std::max(0.2, 0.9 * std::pow(error, -1.0 / 3.0))) :
+            5.0;
+
+        if (error <= 1.0 || h <= min_step)
+        {
+            // Accept the sub-step and keep the final stage as the next first stage
+            time += h;
+            last_sub_steps += 1;
+
+            save_state(bodies, initial);
+            std::swap(k1, k4);
+
+            sub_step = truncated ? std::max(sub_step, h * scale) : h * scale;
+        }
+        else
+        {
+            // Reject the sub-step and retry from the same initial state with a smaller step
+            sub_step = std::max(min_step, h * scale);
+        }
+    }
+
+    sub_step = std::min(sub_step, dt);
+
+    wrap_rotations(bodies);
+}
+
+size_t AdaptiveIntegrator::get_last_sub_steps() const
+{
+    return last_sub_steps;
+}
+
+void AdaptiveIntegrator::set_stage_state(
+    RigidBodySet& bodies,
+    const double h,
+    const double w1,
+    const double w2,
+    const double w3,
+    const double w4)
+{
+    const auto fields = state_fields(bodies);
+
+    for (size_t j = 0; j < BodyStateArrays::FIELD_COUNT; ++j)
+    {
+        for (size_t i = 0; i < bodies.size(); ++i)
+        {
+            (*fields[j])[i] = initial.fields[j][i] + h * (
+                w1 * k1.fields[j][i] +
+                w2 * k2.fields[j][i] +
+                w3 * k3.fields[j][i] +
+                w4 * k4.fields[j][i]);
+        }
+    }
+}
@@ -0,0 +1,218 @@
+#ifndef GIO_INTEGRATOR_H
+#define GIO_INTEGRATOR_H
+
+#include <gamelib/rigid_body_set.h>
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <vector>
+
+struct PhysicsState;
+
+/**
+ * @brief the integration methods available to advance a rigid body set
+ */
+enum class IntegratorType
+{
+    SEMI_IMPLICIT_EULER,
+    VELOCITY_VERLET,
+    RK4,
+    ADAPTIVE
+};
+
+/**
+ * @brief provides the command-line name of an integrator type
+ * @param type the integrator type
+ * @return the name of the integrator
+ */
+const char* integrator_name(const IntegratorType type);
+
+/**
+ * @brief parses an integrator type from its command-line name
+ * @param name the name to parse
+ * @param type set to the parsed type if the name is known
+ * @return true if the name was parsed
+ */
+bool integrator_from_name(
+    const char* name,
+    IntegratorType& type);
+
+/**
+ * @brief stores the position and velocity state of every body within a rigid body set,
+ * as used by the multi-stage integrators for saved states and derivatives
+ */
+struct BodyStateArrays
+{
+    static const size_t FIELD_COUNT = 6;
+
+    /**
+     * @brief the position x, position y, velocity x, velocity y, rotation, and rotational velocity arrays
+     */
+    std::vector<double> fields[FIELD_COUNT];
+
+    /**
+     * @brief resizes every field to the number of bodies provided
+     * @param count the number of bodies
+     */
+    void resize(const size_t count);
+};
+
+/**
+ * @brief Advances the bodies within a rigid body set over a single physics time step
+ */
+class Integrator
+{
+public:
+    /**
+     * @brief resets and re-accumulates the forces and moments on every body for the body state currently
+     * stored in the set. Multi-stage integrators call this several times within a single step, providing
+     * the time since the start of the step that the body state applies to
+     */
+    using ForceFunction = std::function<void(double stage_time)>;
+
+    /**
+     * @brief creates a new integrator of the requested type
+     * @param type the integrator type to create
+     * @return the new integrator
+     */
+    static std::unique_ptr<Integrator> create(const IntegratorType type);
+
+    /**
+     * @brief provides the type of the integrator
+     * @return the integrator type
+     */
+    virtual IntegratorType get_type() const = 0;
+
+    /**
+     * @brief integrates the bodies over the time step of the provided state
+     * @param bodies the bodies to integrate
+     * @param state the physics state providing the time step and gravity
+     * @param apply_forces the function used to evaluate forces for the current body state
+     */
+    virtual void integrate(
+        RigidBodySet& bodies,
+        const PhysicsState& state,
+        const ForceFunction& apply_forces) = 0;
+
+    /**
+     * @brief virtual destructor
+     */
+    virtual ~Integrator();
+
+protected:
+    /**
+     * @brief saves the body state within the set
+     */
+    static void save_state(
+        const RigidBodySet& bodies,
+        BodyStateArrays& saved);
+
+    /**
+     * @brief computes the state derivative of every body from the current state and accumulated forces
+     */
+    static void compute_derivative(
+        const RigidBodySet& bodies,
+        const PhysicsState& state,
+        BodyStateArrays& derivative);
+
+    /**
+     * @brief wraps the rotation of every body into [-pi, pi)
+     */
+    static void wrap_rotations(RigidBodySet& bodies);
+};
+
+/**
+ * @brief Integrates with semi-implicit Euler, using a single force evaluation per step and the
+ * vectorized integrator kernel, matching the original per-object integration
+ */
+class SemiImplicitEulerIntegrator : public Integrator
+{
+public:
+    IntegratorType get_type() const override;
+
+    void integrate(
+        RigidBodySet& bodies,
+        const PhysicsState& state,
+        const ForceFunction& apply_forces) override;
+};
+
+/**
+ * @brief Integrates with kick-drift-kick velocity Verlet, using two force evaluations per step
+ */
+class VelocityVerletIntegrator : public Integrator
+{
+public:
+    IntegratorType get_type() const override;
+
+    void integrate(
+        RigidBodySet& bodies,
+        const PhysicsState& state,
+        const ForceFunction& apply_forces) override;
+};
+
+/**
+ * @brief Integrates with the classic fourth-order Runge-Kutta method, using four force evaluations per step
+ */
+class RK4Integrator : public Integrator
+{
+public:
+    IntegratorType get_type() const override;
+
+    void integrate(
+        RigidBodySet& bodies,
+        const PhysicsState& state,
+        const ForceFunction& apply_forces) override;
+
+protected:
+    BodyStateArrays initial;
+    BodyStateArrays derivative;
+    BodyStateArrays weighted_sum;
+};
+
+/**
+ * @brief Integrates with the embedded Bogacki-Shampine 3(2) method, splitting each time step into
+ * sub-steps sized to keep the estimated local error within PhysicsState::adaptive_tolerance
+ */
+class AdaptiveIntegrator : public Integrator
+{
+public:
+    AdaptiveIntegrator();
+
+    IntegratorType get_type() const override;
+
+    void integrate(
+        RigidBodySet& bodies,
+        const PhysicsState& state,
+        const ForceFunction& apply_forces) override;
+
+    /**
+     * @brief provides the number of accepted sub-steps taken in the last call to integrate
+     * @return the number of sub-steps
+     */
+    size_t get_last_sub_steps() const;
+
+protected:
+    /**
+     * @brief sets the body state to the initial state plus a weighted sum of the stage derivatives
+     */
+    void set_stage_state(
+        RigidBodySet& bodies,
+        const double h,
+        const double w1,
+        const double w2,
+        const double w3,
+        const double w4);
+
+protected:
+    double sub_step;
+    size_t last_sub_steps;
+
+    BodyStateArrays initial;
+    BodyStateArrays k1;
+    BodyStateArrays k2;
+    BodyStateArrays k3;
+    BodyStateArrays k4;
+};
+
+#endif // GIO_INTEGRATOR_H
@@ -0,0 +1,242 @@
+#include <gamelib/integrator_kernel.h>
+
+#include <gamelib/constants.h>
+#include <gamelib/physics_object.h>
+#include <gamelib/rigid_body_set.h>
+
+#include <cmath>
+#include <cstddef>
+
+#if defined(__AVX2__)
+#define GIO_INTEGRATOR_AVX2
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define GIO_INTEGRATOR_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace
+{
+    const double two_pi = 2.0 * gio::pi;
+    const double inv_two_pi = 1.0 / two_pi;
+
+    /**
+     * @brief wraps the angle into [-pi, pi) without branching
+     */
+    inline double wrap_angle_fast(const double angle)
+    {
+        return angle - two_pi * std::floor((angle + gio::pi) * inv_two_pi);
+    }
+
+    /**
+     * @brief wraps the angle with the same std::fmod expression as the original per-object integration
+     */
+    inline double wrap_angle_strict(const double angle)
+    {
+        return std::fmod(angle + gio::pi, two_pi) - gio::pi;
+    }
+
+    /**
+     * @brief integrates the bodies in [start, count) one at a time
+     */
+    void integrate_range_scalar(
+        RigidBodySet& bodies,
+        const PhysicsState& state,
+        const size_t start)
+    {
+        // Extract the time step and gravity contribution
+        const double dt = state.time_step;
+        const double gravity_dx = state.gravity.x * dt;
+        const double gravity_dy = state.gravity.y * dt;
+
+        const size_t count = bodies.size();
+
+        // Integrate translational motion
+        for (size_t i = start; i < count; ++i)
+        {
+            const double inv_mass = 1.0 / bodies.mass[i];
+
+            bodies.velocity_x[i] += bodies.force_x[i] * inv_mass * dt + gravity_dx;
+            bodies.velocity_y[i] += bodies.force_y[i] * inv_mass * dt + gravity_dy;
+
+            bodies.position_x[i] += bodies.velocity_x[i] * dt;
+            bodies.position_y[i] += bodies.velocity_y[i] * dt;
+        }
+
+        // Integrate rotational motion
+        for (size_t i = start; i < count; ++i)
+        {
+            bodies.rotational_vel[i] += bodies.moment[i] / bodies.inertia[i] * dt;
+            bodies.rotation[i] += bodies.rotational_vel[i] * dt;
+            bodies.rotation[i] = state.strict_integration ?
+                wrap_angle_strict(bodies.rotation[i]) :
+                wrap_angle_fast(bodies.rotation[i]);
+        }
+    }
+
+#if defined(GIO_INTEGRATOR_AVX2)
+    const size_t lane_count = 4;
+
+    /**
+     * @brief integrates as many bodies as fit within full AVX2 vectors
+     * @return the number of bodies integrated
+     */
+    size_t integrate_range_vector(
+        RigidBodySet& bodies,
+        const PhysicsState& state)
+    {
+        const size_t count = bodies.size() - bodies.size() % lane_count;
+
+        const __m256d dt = _mm256_set1_pd(state.time_step);
+        const __m256d gravity_dx = _mm256_set1_pd(state.gravity.x * state.time_step);
+        const __m256d gravity_dy = _mm256_set1_pd(state.gravity.y * state.time_step);
+        const __m256d one = _mm256_set1_pd(1.0);
+        const __m256d pi = _mm256_set1_pd(gio::pi);
+        const __m256d two_pi_vec = _mm256_set1_pd(two_pi);
+        const __m256d inv_two_pi_vec = _mm256_set1_pd(inv_two_pi);
+
+        for (size_t i = 0; i < count; i += lane_count)
+        {
+            // Integrate translational motion
+            const __m256d inv_mass = _mm256_div_pd(one, _mm256_loadu_pd(&bodies.mass[i]));
+
+            __m256d vel_x = _mm256_loadu_pd(&bodies.velocity_x[i]);
+            __m256d vel_y = _mm256_loadu_pd(&bodies.velocity_y[i]);
+
+            vel_x = _mm256_add_pd(vel_x, _mm256_add_pd(_mm256_mul_pd(_mm256_mul_pd(_mm256_loadu_pd(&bodies.force_x[i]), inv_mass), dt), gravity_dx));
+            vel_y = _mm256_add_pd(vel_y, _mm256_add_pd(_mm256_mul_pd(_mm256_mul_pd(_mm256_loadu_pd(&bodies.force_y[i]), inv_mass), dt), gravity_dy));
+
+            _mm256_storeu_pd(&bodies.velocity_x[i], vel_x);
+            _mm256_storeu_pd(&bodies.velocity_y[i], vel_y);
+            _mm256_storeu_pd(&bodies.position_x[i], _mm256_add_pd(_mm256_loadu_pd(&bodies.position_x[i]), _mm256_mul_pd(vel_x, dt)));
+            _mm256_storeu_pd(&bodies.position_y[i], _mm256_add_pd(_mm256_loadu_pd(&bodies.position_y[i]), _mm256_mul_pd(vel_y, dt)));
+
+            // Integrate rotational motion
+            __m256d rot_vel = _mm256_loadu_pd(&bodies.rotational_vel[i]);
+            rot_vel = _mm256_add_pd(rot_vel, _mm256_mul_pd(_mm256_div_pd(_mm256_loadu_pd(&bodies.moment[i]), _mm256_loadu_pd(&bodies.inertia[i])), dt));
+
+            __m256d rot = _mm256_add_pd(_mm256_loadu_pd(&bodies.rotation[i]), _mm256_mul_pd(rot_vel, dt));
+
+            _mm256_storeu_pd(&bodies.rotational_vel[i], rot_vel);
+
+            if (!state.strict_integration)
+            {
+                const __m256d turns = _mm256_floor_pd(_mm256_mul_pd(_mm256_add_pd(rot, pi), inv_two_pi_vec));
+                rot = _mm256_sub_pd(rot, _mm256_mul_pd(two_pi_vec, turns));
+            }
+
+            _mm256_storeu_pd(&bodies.rotation[i], rot);
+        }
+
+        return count;
+    }
+#elif defined(GIO_INTEGRATOR_SSE2)
+    const size_t lane_count = 2;
+
+    /**
+     * @brief computes the floor of each lane without branching, valid for values within the int32 range
+     */
+    inline __m128d floor_pd(const __m128d val)
+    {
+        const __m128d truncated = _mm_cvtepi32_pd(_mm_cvttpd_epi32(val));
+        const __m128d correction = _mm_and_pd(_mm_cmpgt_pd(truncated, val), _mm_set1_pd(1.0));
+        return _mm_sub_pd(truncated, correction);
+    }
+
+    /**
+     * @brief integrates as many bodies as fit within full SSE2 vectors
+     * @return the number of bodies integrated
+     */
+    size_t integrate_range_vector(
+        RigidBodySet& bodies,
+        const PhysicsState& state)
+    {
+        const size_t count = bodies.size() - bodies.size() % lane_count;
+
+        const __m128d dt = _mm_set1_pd(state.time_step);
+        const __m128d gravity_dx = _mm_set1_pd(state.gravity.x * state.time_step);
+        const __m128d gravity_dy = _mm_set1_pd(state.gravity.y * state.time_step);
+        const __m128d one = _mm_set1_pd(1.0);
+        const __m128d pi = _mm_set1_pd(gio::pi);
+        const __m128d two_pi_vec = _mm_set1_pd(two_pi);
+        const __m128d inv_two_pi_vec = _mm_set1_pd(inv_two_pi);
+
+        for (size_t i = 0; i < count; i += lane_count)
+        {
+            // Integrate translational motion
+            const __m128d inv_mass = _mm_div_pd(one, _mm_loadu_pd(&bodies.mass[i]));
+
+            __m128d vel_x = _mm_loadu_pd(&bodies.velocity_x[i]);
+            __m128d vel_y = _mm_loadu_pd(&bodies.velocity_y[i]);
+
+            vel_x = _mm_add_pd(vel_x, _mm_add_pd(_mm_mul_pd(_mm_mul_pd(_mm_loadu_pd(&bodies.force_x[i]), inv_mass), dt), gravity_dx));
+            vel_y = _mm_add_pd(vel_y, _mm_add_pd(_mm_mul_pd(_mm_mul_pd(_mm_loadu_pd(&bodies.force_y[i]), inv_mass), dt), gravity_dy));
+
+            _mm_storeu_pd(&bodies.velocity_x[i], vel_x);
+            _mm_storeu_pd(&bodies.velocity_y[i], vel_y);
+            _mm_storeu_pd(&bodies.position_x[i], _mm_add_pd(_mm_loadu_pd(&bodies.position_x[i]), _mm_mul_pd(vel_x, dt)));
+            _mm_storeu_pd(&bodies.position_y[i], _mm_add_pd(_mm_loadu_pd(&bodies.position_y[i]), _mm_mul_pd(vel_y, dt)));
+
+            // Integrate rotational motion
+            __m128d rot_vel = _mm_loadu_pd(&bodies.rotational_vel[i]);
+            rot_vel = _mm_add_pd(rot_vel, _mm_mul_pd(_mm_div_pd(_mm_loadu_pd(&bodies.moment[i]), _mm_loadu_pd(&bodies.inertia[i])), dt));
+
+            __m128d rot = _mm_add_pd(_mm_loadu_pd(&bodies.rotation[i]), _mm_mul_pd(rot_vel, dt));
+
+            _mm_storeu_pd(&bodies.rotational_vel[i], rot_vel);
+
+            if (!state.strict_integration)
+            {
+                const __m128d turns = floor_pd(_mm_mul_pd(_mm_add_pd(rot, pi), inv_two_pi_vec));
+                rot = _mm_sub_pd(rot, _mm_mul_pd(two_pi_vec, turns));
+            }
+
+            _mm_storeu_pd(&bodies.rotation[i], rot);
+        }
+
+        return count;
+    }
+#endif
+}
+
+const char* gio::integrator_kernel_isa()
+{
+#if defined(GIO_INTEGRATOR_AVX2)
+    return "avx2";
+#elif defined(GIO_INTEGRATOR_SSE2)
+    return "sse2";
+#else
+    return "scalar";
+#endif
+}
+
+void gio::integrate_bodies(
+    RigidBodySet& bodies,
+    const PhysicsState& state)
+{
+#if defined(GIO_INTEGRATOR_AVX2) || defined(GIO_INTEGRATOR_SSE2)
+    // Integrate full vectors of bodies
+    const size_t vector_count = integrate_range_vector(bodies, state);
+
+    // Strict mode keeps the std::fmod wrap so that results match the scalar path exactly
+    if (state.strict_integration)
+    {
+        for (size_t i = 0; i < vector_count; ++i)
+        {
+            bodies.rotation[i] = wrap_angle_strict(bodies.rotation[i]);
+        }
+    }
+
+    // Integrate any remaining bodies one at a time
+    integrate_range_scalar(bodies, state, vector_count);
+#else
+    integrate_range_scalar(bodies, state, 0);
+#endif
+}
+
+void gio::integrate_bodies_scalar(
+    RigidBodySet& bodies,
+    const PhysicsState& state)
+{
+    integrate_range_scalar(bodies, state, 0);
+}
@@ -0,0 +1,39 @@
+#ifndef GIO_INTEGRATOR_KERNEL_H
+#define GIO_INTEGRATOR_KERNEL_H
+
+class RigidBodySet;
+struct PhysicsState;
+
+namespace gio
+{
+
+    /**
+     * @brief provides the name of the instruction set used by the vectorized integration kernel
+     * @return the instruction set name, such as "avx2", "sse2", or "scalar"
+     */
+    const char* integrator_kernel_isa();
+
+    /**
+     * @brief integrates the translation and rotation of every body in the set with semi-implicit Euler,
+     * using the widest vector instructions available in the current build. In strict mode, the results
+     * are bit-identical to integrate_bodies_scalar; otherwise, rotation wrapping uses a branch-free
+     * floor instead of std::fmod and wraps into [-pi, pi)
+     * @param bodies the bodies to integrate
+     * @param state the physics state providing the time step, gravity, and strictness
+     */
+    void integrate_bodies(
+        RigidBodySet& bodies,
+        const PhysicsState& state);
+
+    /**
+     * @brief integrates every body in the set one at a time, providing the reference results for integrate_bodies
+     * @param bodies the bodies to integrate
+     * @param state the physics state providing the time step, gravity, and strictness
+     */
+    void integrate_bodies_scalar(
+        RigidBodySet& bodies,
+        const PhysicsState& state);
+
+}
+
+#endif // GIO_INTEGRATOR_KERNEL_H
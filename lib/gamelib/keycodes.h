@@ -0,0 +1,34 @@
+#ifndef GIO_KEYCODES_H
+#define GIO_KEYCODES_H
+
+#ifndef GIO_HEADLESS
+
+#include <allegro5/keycodes.h>
+
+#else
+
+/**
+ * @brief headless builds are compiled without any Allegro headers, so provide the
+ * subset of keycodes used by the simulation with the same values as allegro5/keycodes.h
+ */
+enum
+{
+    ALLEGRO_KEY_A = 1,
+    ALLEGRO_KEY_D = 4,
+    ALLEGRO_KEY_S = 19,
+    ALLEGRO_KEY_W = 23,
+
+    ALLEGRO_KEY_1 = 28,
+    ALLEGRO_KEY_2 = 29,
+
+    ALLEGRO_KEY_LEFT = 82,
+    ALLEGRO_KEY_RIGHT = 83,
+    ALLEGRO_KEY_UP = 84,
+    ALLEGRO_KEY_DOWN = 85,
+
+    ALLEGRO_KEY_MAX = 227
+};
+
+#endif // GIO_HEADLESS
+
+#endif // GIO_KEYCODES_H
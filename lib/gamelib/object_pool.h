@@ -0,0 +1,229 @@
+#ifndef GIO_OBJECT_POOL_H
+#define GIO_OBJECT_POOL_H
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Owns any number of objects in fixed-size blocks of slots. Objects never move once created, so
+ * that other objects may keep pointers to them, and destroyed slots are reused by the next object
+ * created, so that creating and destroying objects only allocates when every slot is in use. Objects
+ * are visited in slot order, which keeps iteration deterministic
+ * @tparam T the object type
+ */
+template <typename T>
+class ObjectPool
+{
+public:
+    /**
+     * @brief constructs an empty pool
+     * @param block_size the number of slots allocated together whenever the pool grows
+     */
+    explicit ObjectPool(const size_t block_size = 16) :
+        block_size(block_size > 0 ? block_size : 1),
+        live_count(0)
+    {
+        // Empty Constructor
+    }
+
+    /**
+     * @brief destroys every live object
+     */
+    ~ObjectPool()
+    {
+        clear();
+    }
+
+    ObjectPool(const ObjectPool&) = delete;
+    ObjectPool& operator=(const ObjectPool&) = delete;
+
+    /**
+     * @brief allocates enough slots to hold the given number of objects without growing
+     * @param count the number of objects to make room for
+     */
+    void reserve(const size_t count)
+    {
+        while (capacity() < count)
+        {
+            add_block();
+        }
+    }
+
+    /**
+     * @brief constructs a new object in a free slot, growing the pool if every slot is in use
+     * @param args the constructor arguments
+     * @return the new object, which remains at the same address until destroyed
+     */
+    template <typename... Args>
+    T* create(Args&&... args)
+    {
+        if (free_slots.empty())
+        {
+            add_block();
+        }
+
+        Slot* slot = free_slots.back();
+
+        T* object = new (&slot->storage) T(std::forward<Args>(args)...);
+
+        free_slots.pop_back();
+        slot->alive = true;
+        ++live_count;
+
+        return object;
+    }
+
+    /**
+     * @brief destroys an object created by this pool and frees its slot
+     * @param object the object to destroy, which may be nullptr
+     */
+    void destroy(T* object)
+    {
+        if (object == nullptr)
+        {
+            return;
+        }
+
+        Slot* slot = reinterpret_cast<Slot*>(object);
+        if (!slot->alive)
+        {
+            return;
+        }
+
+        object->~T();
+
+        slot->alive = false;
+        free_slots.push_back(slot);
+        --live_count;
+    }
+
+    /**
+     * @brief destroys every live object, keeping the slots for reuse
+     */
+    void clear()
+    {
+        for (auto& block : blocks)
+        {
+            for (size_t i = 0; i < block_size; ++i)
+            {
+                destroy(object_in(block[i]));
+            }
+        }
+
+        // Reuse the lowest slots first, as a new pool would
+        free_slots.clear();
+        for (size_t b = blocks.size(); b-- > 0;)
+        {
+            for (size_t i = block_size; i-- > 0;)
+            {
+                free_slots.push_back(&blocks[b][i]);
+            }
+        }
+    }
+
+    /**
+     * @brief calls a function with each live object, in slot order. The function must not create or
+     * destroy objects in this pool
+     * @param function the function to call with a reference to each object
+     */
+    template <typename Function>
+    void for_each(Function function)
+    {
+        for (auto& block : blocks)
+        {
+            for (size_t i = 0; i < block_size; ++i)
+            {
+                if (block[i].alive)
+                {
+                    function(*object_in(block[i]));
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief calls a function with each live object, in slot order
+     * @param function the function to call with a const reference to each object
+     */
+    template <typename Function>
+    void for_each(Function function) const
+    {
+        for (const auto& block : blocks)
+        {
+            for (size_t i = 0; i < block_size; ++i)
+            {
+                if (block[i].alive)
+                {
+                    function(*reinterpret_cast<const T*>(&block[i].storage));
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief provides the number of live objects
+     * @return the object count
+     */
+    size_t size() const
+    {
+        return live_count;
+    }
+
+    /**
+     * @brief provides the number of slots allocated
+     * @return the slot count
+     */
+    size_t capacity() const
+    {
+        return blocks.size() * block_size;
+    }
+
+protected:
+    /**
+     * @brief storage for a single object, with the object first so that an object pointer is also a slot pointer
+     */
+    struct Slot
+    {
+        typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+        bool alive = false;
+    };
+
+    static_assert(std::is_standard_layout<Slot>::value, "pool slots must be standard layout");
+
+    /**
+     * @brief provides the object stored in a slot, which may not be live
+     */
+    static T* object_in(Slot& slot)
+    {
+        return reinterpret_cast<T*>(&slot.storage);
+    }
+
+    /**
+     * @brief allocates a new block of free slots, to be used after any slots that are already free
+     */
+    void add_block()
+    {
+        blocks.push_back(std::unique_ptr<Slot[]>(new Slot[block_size]));
+
+        Slot* block = blocks.back().get();
+        free_slots.insert(free_slots.begin(), block_size, nullptr);
+
+        for (size_t i = 0; i < block_size; ++i)
+        {
+            free_slots[block_size - 1 - i] = &block[i];
+        }
+    }
+
+protected:
+    size_t block_size;
+    size_t live_count;
+
+    std::vector<std::unique_ptr<Slot[]>> blocks;
+    std::vector<Slot*> free_slots;
+};
+
+#endif // GIO_OBJECT_POOL_H
@@ -4,119 +4,126 @@
 
 #include <cmath>
 
-#include <stdexcept>
-
-PhysicsObject::PhysicsObject() :
-    position(),
-    velocity(),
-    rotation(0.0),
-    rotational_vel(0.0),
-    mass(1.0),
-    inertia(1.0),
-    forces(),
-    moments(0.0)
+PhysicsBody::PhysicsBody(RigidBodySet& body_set) :
+    body_set(&body_set),
+    body_index(body_set.add_body())
 {
-    // Do Nothing
+    // Empty Constructor
 }
 
-void PhysicsObject::add_force_relative(const Vector2& force)
+void PhysicsBody::add_force_relative(const Vector2& force)
 {
     add_force_relative(
         force,
         Vector2());
 }
 
-void PhysicsObject::add_force_relative(
+void PhysicsBody::add_force_relative(
     const Vector2& force,
     const Vector2& offset)
 {
+    const SinCos body_rotation(get_rotation());
+
     add_force_absolute(
-        force.rotate_rad(rotation),
-        offset.rotate_rad(-rotation));
+        force.rotate_rad(body_rotation),
+        offset.rotate_rad(body_rotation.inverse()));
 }
 
-void PhysicsObject::add_force_absolute(const Vector2& force)
+void PhysicsBody::reset_forces()
 {
-    add_force_absolute(
-        force,
-        Vector2());
+    body_set->force_x[body_index] = 0.0;
+    body_set->force_y[body_index] = 0.0;
+    body_set->moment[body_index] = 0.0;
 }
 
-void PhysicsObject::add_force_absolute(
-    const Vector2& force,
-    const Vector2& offset)
+void PhysicsBody::set_position(const Vector2& pos)
 {
-    forces += force;
-    moments += offset.cross(force);
+    set_position(pos.x, pos.y);
 }
 
-void PhysicsObject::step(const StepState* state)
+void PhysicsBody::set_position(const double x, const double y)
 {
-    // Run the super-step
-    StepObject::step(state);
+    body_set->position_x[body_index] = x;
+    body_set->position_y[body_index] = y;
+}
+
+Vector2 PhysicsBody::get_velocity_at_absolute(const Vector2& point) const
+{
+    const Vector2 offset = point - get_position();
+    return get_velocity() + get_rotational_velocity() * Vector2(
+        -offset.y,
+        offset.x);
+}
 
-    // Extract the physics state
-    const PhysicsState* physics = dynamic_cast<const PhysicsState*>(state);
-    if (physics != nullptr)
+Vector2 PhysicsBody::get_draw_position(const double alpha) const
+{
+    const Vector2 current = get_position();
+    if (body_index >= body_set->previous_position_x.size())
     {
-        // Extract the time step
-        const double dt = physics->time_step;
+        return current;
+    }
 
-        // Integrate translational motion
-        velocity += forces / mass * dt + physics->gravity * dt;
-        position += velocity * dt;
+    const Vector2 previous(
+        body_set->previous_position_x[body_index],
+        body_set->previous_position_y[body_index]);
 
-        // Integrate rotational motion
-        rotational_vel += moments / inertia * dt;
-        rotation += rotational_vel * dt;
-        rotation = std::fmod(rotation + gio::pi, 2.0 * gio::pi) - gio::pi;
-    }
-    else
+    return previous + (current - previous) * alpha;
+}
+
+double PhysicsBody::get_draw_rotation(const double alpha) const
+{
+    const double current = get_rotation();
+    if (body_index >= body_set->previous_rotation.size())
     {
-        throw std::runtime_error("physics step must get a physics object for correct computations");
+        return current;
     }
+
+    // Take the shortest signed difference so that wrapping across a full turn interpolates the short way
+    const double previous = body_set->previous_rotation[body_index];
+    const double difference = std::remainder(current - previous, 2.0 * gio::pi);
+
+    return previous + difference * alpha;
 }
 
-void PhysicsObject::post_step(const StepState* state)
+double PhysicsBody::get_mass() const
 {
-    // Run the super-step
-    StepObject::post_step(state);
-    
-    // Clear the forces and moments
-    reset_forces();
+    return body_set->mass[body_index];
 }
 
-void PhysicsObject::reset_forces()
+double PhysicsBody::get_inertia() const
 {
-    forces = Vector2(0.0, 0.0);
-    moments = 0.0;
+    return body_set->inertia[body_index];
 }
 
-void PhysicsObject::set_position(const Vector2& pos)
+void PhysicsBody::apply_impulse(
+    const Vector2& impulse,
+    const Vector2& offset)
 {
-    position = pos;
+    body_set->velocity_x[body_index] += impulse.x / get_mass();
+    body_set->velocity_y[body_index] += impulse.y / get_mass();
+    body_set->rotational_vel[body_index] += offset.cross(impulse) / get_inertia();
 }
 
-void PhysicsObject::set_position(const double x, const double y)
+void PhysicsBody::apply_position_impulse(
+    const Vector2& impulse,
+    const Vector2& offset)
 {
-    position.x = x;
-    position.y = y;
+    body_set->position_x[body_index] += impulse.x / get_mass();
+    body_set->position_y[body_index] += impulse.y / get_mass();
+    body_set->rotation[body_index] += offset.cross(impulse) / get_inertia();
 }
 
-Vector2 PhysicsObject::get_position() const
+void PhysicsBody::set_mass(const double mass)
 {
-    return position;
+    body_set->mass[body_index] = mass;
 }
 
-Vector2 PhysicsObject::get_velocity() const
+void PhysicsBody::set_inertia(const double inertia)
 {
-    return velocity;
+    body_set->inertia[body_index] = inertia;
 }
 
-Vector2 PhysicsObject::get_velocity_at_absolute(const Vector2& point)
+void PhysicsBody::set_moment(const double moment)
 {
-    const Vector2 offset = point - get_position();
-    return velocity + rotational_vel * Vector2(
-        -offset.y,
-        offset.x);
+    body_set->moment[body_index] = moment;
 }
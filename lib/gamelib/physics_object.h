@@ -3,8 +3,12 @@
 
 #include <gamelib/game_object.h>
 
+#include <gamelib/integrator.h>
+#include <gamelib/rigid_body_set.h>
 #include <gamelib/vector2.h>
 
+#include <type_traits>
+
 
 /**
  * @brief provides the core physics state information to pass to an object
@@ -12,18 +16,37 @@
 struct PhysicsState : public StepState
 {
     Vector2 gravity;
+
+    /**
+     * @brief if true, integration results are bit-identical to the scalar reference path so
+     * that recorded runs replay exactly; if false, the integrator may use faster approximations
+    */
+    bool strict_integration = true;
+
+    /**
+     * @brief the integration method used to advance physics bodies over each time step
+    */
+    IntegratorType integrator = IntegratorType::SEMI_IMPLICIT_EULER;
+
+    /**
+     * @brief the relative and absolute local error tolerance used by the adaptive integrator
+    */
+    double adaptive_tolerance = 1e-4;
 };
 
 /**
- * @brief provides a basic physics object to use within a game
+ * @brief provides a handle to a single body within a rigid body set, along with force
+ * accumulation and state access for that body. Integration is performed for all bodies
+ * at once by the owning RigidBodySet
 */
-class PhysicsObject : public GameObject
+class PhysicsBody
 {
 public:
     /**
-     * @brief constructs the basic physics object
+     * @brief constructs the physics body as a new body within the given set
+     * @param body_set the rigid body set to store the body state in
     */
-    PhysicsObject();
+    explicit PhysicsBody(RigidBodySet& body_set);
 
     /**
      * @brief Applies a relative force to the object
@@ -56,21 +79,15 @@ public:
         const Vector2& offset);
 
     /**
-     * @brief Steps the core physics state
-     * @param state the step (physics) state to use
-    */
-    virtual void step(const StepState* state) override;
-
-    /**
-     * @brief Runs after the main step
-     * @param state the step state to use
+     * @brief Applies a moment to the object
+     * @param moment the moment to apply
      */
-    virtual void post_step(const StepState* state) override;
+    void add_moment(const double moment);
 
     /**
      * @brief Resets all forces and moments within the physics object to 0
      */
-    virtual void reset_forces();
+    void reset_forces();
 
     /**
      * @brief Sets the position to the position given
@@ -97,25 +114,171 @@ public:
      */
     Vector2 get_velocity() const;
 
+    /**
+     * @brief Provides the current object rotation
+     * @return the current rotation, in radians
+     */
+    double get_rotation() const;
+
+    /**
+     * @brief Provides the current object rotational velocity
+     * @return the current rotational velocity, in radians per second
+     */
+    double get_rotational_velocity() const;
+
+    /**
+     * @brief Provides the object position to draw, interpolated between the previous pose stored
+     * in the body set and the current position
+     * @param alpha the interpolation fraction, from 0 at the previous pose to 1 at the current pose
+     * @return the position to draw, or the current position if no previous pose is stored
+     */
+    Vector2 get_draw_position(const double alpha) const;
+
+    /**
+     * @brief Provides the object rotation to draw, interpolated along the shortest arc between the
+     * previous pose stored in the body set and the current rotation, so that a rotation which has
+     * wrapped around a full turn does not spin backwards
+     * @param alpha the interpolation fraction, from 0 at the previous pose to 1 at the current pose
+     * @return the rotation to draw, in radians, or the current rotation if no previous pose is stored
+     */
+    double get_draw_rotation(const double alpha) const;
+
     /**
      * @brief Provides the current object velocity at the point requested
      * @param point the other point to check the velocity at in absolute coordinates
      * @return the current velocity at the point provided
      */
-    Vector2 get_velocity_at_absolute(const Vector2& point);
+    Vector2 get_velocity_at_absolute(const Vector2& point) const;
+
+    /**
+     * @brief Provides the mass of the object
+     * @return the mass
+     */
+    double get_mass() const;
+
+    /**
+     * @brief Provides the rotational inertia of the object
+     * @return the inertia
+     */
+    double get_inertia() const;
+
+    /**
+     * @brief Applies an impulse to the object in the global frame, immediately changing the velocities
+     * @param impulse the impulse to apply
+     * @param offset the offset from the center of mass to apply the impulse at, from the global frame
+     */
+    void apply_impulse(
+        const Vector2& impulse,
+        const Vector2& offset);
+
+    /**
+     * @brief Applies a position-level impulse to the object in the global frame, immediately moving and
+     * rotating the object as an impulse would change its velocities, for use by position-based constraints
+     * @param impulse the position impulse to apply
+     * @param offset the offset from the center of mass to apply the impulse at, from the global frame
+     */
+    void apply_position_impulse(
+        const Vector2& impulse,
+        const Vector2& offset);
 
 protected:
-    Vector2 position;
-    Vector2 velocity;
-    
-    double rotation;
-    double rotational_vel;
+    /**
+     * @brief Sets the mass of the object
+     * @param mass the new mass
+     */
+    void set_mass(const double mass);
+
+    /**
+     * @brief Sets the rotational inertia of the object
+     * @param inertia the new inertia
+     */
+    void set_inertia(const double inertia);
+
+    /**
+     * @brief Provides the moment accumulated for the current step
+     * @return the current moment
+     */
+    double get_moment() const;
+
+    /**
+     * @brief Overrides the moment accumulated for the current step
+     * @param moment the new moment
+     */
+    void set_moment(const double moment);
+
+protected:
+    RigidBodySet* body_set;
+    size_t body_index;
+};
+
+inline void PhysicsBody::add_force_absolute(const Vector2& force)
+{
+    body_set->force_x[body_index] += force.x;
+    body_set->force_y[body_index] += force.y;
+}
+
+inline void PhysicsBody::add_force_absolute(
+    const Vector2& force,
+    const Vector2& offset)
+{
+    add_force_absolute(force);
+    body_set->moment[body_index] += offset.cross(force);
+}
 
-    double mass;
-    double inertia;
+inline void PhysicsBody::add_moment(const double moment)
+{
+    body_set->moment[body_index] += moment;
+}
+
+inline Vector2 PhysicsBody::get_position() const
+{
+    return Vector2(
+        body_set->position_x[body_index],
+        body_set->position_y[body_index]);
+}
+
+inline Vector2 PhysicsBody::get_velocity() const
+{
+    return Vector2(
+        body_set->velocity_x[body_index],
+        body_set->velocity_y[body_index]);
+}
 
-    Vector2 forces;
-    double moments;
+inline double PhysicsBody::get_rotation() const
+{
+    return body_set->rotation[body_index];
+}
+
+inline double PhysicsBody::get_rotational_velocity() const
+{
+    return body_set->rotational_vel[body_index];
+}
+
+inline double PhysicsBody::get_moment() const
+{
+    return body_set->moment[body_index];
+}
+
+/**
+ * @brief provides a basic physics object to use within a game
+ * @tparam StateType the step state type, which must provide the physics state parameters
+*/
+template <typename StateType>
+class PhysicsObject : public GameObject<StateType>, public PhysicsBody
+{
+    static_assert(std::is_base_of<PhysicsState, StateType>::value, "physics objects must be stepped with a PhysicsState-derived state");
+
+public:
+    /**
+     * @brief constructs the physics object as a new body within the given set
+     * @param body_set the rigid body set to store the body state in, which is responsible for
+     * integrating the body and resetting its forces after each step
+    */
+    explicit PhysicsObject(RigidBodySet& body_set) :
+        PhysicsBody(body_set)
+    {
+        // Empty Constructor
+    }
 };
 
 #endif // GIO_PHYSICS_OBJECT_H
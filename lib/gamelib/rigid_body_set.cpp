@@ -0,0 +1,74 @@
+#include <gamelib/rigid_body_set.h>
+
+#include <gamelib/integrator_kernel.h>
+
+#include <algorithm>
+
+RigidBodySet::RigidBodySet()
+{
+    // Empty Constructor
+}
+
+size_t RigidBodySet::add_body()
+{
+    position_x.push_back(0.0);
+    position_y.push_back(0.0);
+
+    velocity_x.push_back(0.0);
+    velocity_y.push_back(0.0);
+
+    rotation.push_back(0.0);
+    rotational_vel.push_back(0.0);
+
+    mass.push_back(1.0);
+    inertia.push_back(1.0);
+
+    force_x.push_back(0.0);
+    force_y.push_back(0.0);
+    moment.push_back(0.0);
+
+    return size() - 1;
+}
+
+size_t RigidBodySet::size() const
+{
+    return position_x.size();
+}
+
+void RigidBodySet::integrate(const PhysicsState& state)
+{
+    gio::integrate_bodies(*this, state);
+}
+
+void RigidBodySet::reset_forces()
+{
+    std::fill(force_x.begin(), force_x.end(), 0.0);
+    std::fill(force_y.begin(), force_y.end(), 0.0);
+    std::fill(moment.begin(), moment.end(), 0.0);
+}
+
+void RigidBodySet::store_previous_poses()
+{
+    previous_position_x = position_x;
+    previous_position_y = position_y;
+    previous_rotation = rotation;
+}
+
+void RigidBodySet::copy_state(const RigidBodySet& other)
+{
+    position_x = other.position_x;
+    position_y = other.position_y;
+
+    velocity_x = other.velocity_x;
+    velocity_y = other.velocity_y;
+
+    rotation = other.rotation;
+    rotational_vel = other.rotational_vel;
+
+    mass = other.mass;
+    inertia = other.inertia;
+
+    force_x = other.force_x;
+    force_y = other.force_y;
+    moment = other.moment;
+}
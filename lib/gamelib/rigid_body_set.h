@@ -0,0 +1,80 @@
+#ifndef GIO_RIGID_BODY_SET_H
+#define GIO_RIGID_BODY_SET_H
+
+#include <cstddef>
+#include <vector>
+
+struct PhysicsState;
+
+/**
+ * @brief Stores the rigid body state of many physics bodies as contiguous per-field arrays,
+ * so that all bodies in the set can be integrated in a single loop
+ */
+class RigidBodySet
+{
+public:
+    /**
+     * @brief constructs an empty rigid body set
+     */
+    RigidBodySet();
+
+    /**
+     * @brief adds a new body at rest at the origin with unit mass and inertia
+     * @return the index of the new body within the set
+     */
+    size_t add_body();
+
+    /**
+     * @brief provides the number of bodies within the set
+     * @return the number of bodies
+     */
+    size_t size() const;
+
+    /**
+     * @brief integrates the current forces and moments of every body over the physics time step
+     * with the vectorized integrator kernel
+     * @param state the physics state to use
+     */
+    void integrate(const PhysicsState& state);
+
+    /**
+     * @brief resets the forces and moments of every body to 0
+     */
+    void reset_forces();
+
+    /**
+     * @brief copies the current pose of every body into the previous pose arrays, so that drawing
+     * can interpolate from the previous pose towards the next state copied in
+     */
+    void store_previous_poses();
+
+    /**
+     * @brief copies the body state of another set with the same bodies, leaving the previous
+     * poses untouched
+     * @param other the set to copy from
+     */
+    void copy_state(const RigidBodySet& other);
+
+public:
+    std::vector<double> position_x;
+    std::vector<double> position_y;
+
+    std::vector<double> velocity_x;
+    std::vector<double> velocity_y;
+
+    std::vector<double> rotation;
+    std::vector<double> rotational_vel;
+
+    std::vector<double> mass;
+    std::vector<double> inertia;
+
+    std::vector<double> force_x;
+    std::vector<double> force_y;
+    std::vector<double> moment;
+
+    std::vector<double> previous_position_x;
+    std::vector<double> previous_position_y;
+    std::vector<double> previous_rotation;
+};
+
+#endif // GIO_RIGID_BODY_SET_H
@@ -0,0 +1,120 @@
+#ifndef GIO_SAMPLE_RING_H
+#define GIO_SAMPLE_RING_H
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+
+/**
+ * @brief Holds the newest samples of a measurement in a fixed-size ring, overwriting the oldest sample
+ * once full, and provides rolling statistics over the samples held. Adding a sample and computing the
+ * statistics never allocate
+ * @tparam N the number of samples held
+ */
+template <size_t N>
+class SampleRing
+{
+public:
+    static_assert(N > 0, "sample rings must hold at least one sample");
+
+    /**
+     * @brief constructs an empty ring
+     */
+    SampleRing() :
+        next_index(0),
+        count(0)
+    {
+        samples.fill(0.0);
+    }
+
+    /**
+     * @brief adds a sample, replacing the oldest sample if the ring is full
+     * @param value the sample value
+     */
+    void add(const double value)
+    {
+        samples[next_index] = value;
+        next_index = (next_index + 1) % N;
+        count = std::min(count + 1, N);
+    }
+
+    /**
+     * @brief removes all samples
+     */
+    void clear()
+    {
+        next_index = 0;
+        count = 0;
+    }
+
+    /**
+     * @brief provides the number of samples held
+     * @return the sample count, which is at most N
+     */
+    size_t size() const
+    {
+        return count;
+    }
+
+    /**
+     * @brief provides the newest sample
+     * @return the newest sample, or 0 if the ring is empty
+     */
+    double latest() const
+    {
+        return (count > 0) ? samples[(next_index + N - 1) % N] : 0.0;
+    }
+
+    /**
+     * @brief provides the mean of the samples held
+     * @return the mean, or 0 if the ring is empty
+     */
+    double average() const
+    {
+        if (count == 0)
+        {
+            return 0.0;
+        }
+
+        double sum = 0.0;
+        for (size_t i = 0; i < count; ++i)
+        {
+            sum += samples[i];
+        }
+
+        return sum / static_cast<double>(count);
+    }
+
+    /**
+     * @brief provides the smallest sample that at least the given fraction of the samples do not exceed,
+     * such as 0.99 for the 99th percentile
+     * @param fraction the fraction, from 0 to 1
+     * @return the percentile, or 0 if the ring is empty
+     */
+    double percentile(const double fraction) const
+    {
+        if (count == 0)
+        {
+            return 0.0;
+        }
+
+        // Select the sample from a copy on the stack, since the ring is kept in insertion order
+        std::array<double, N> sorted;
+        std::copy(samples.begin(), samples.begin() + count, sorted.begin());
+
+        // Use the nearest rank, so that the 99th percentile of 100 samples is the second largest
+        const double rank = std::ceil(std::min(std::max(fraction, 0.0), 1.0) * static_cast<double>(count));
+        const size_t index = (rank < 1.0) ? 0 : std::min(count - 1, static_cast<size_t>(rank) - 1);
+
+        std::nth_element(sorted.begin(), sorted.begin() + index, sorted.begin() + count);
+        return sorted[index];
+    }
+
+protected:
+    std::array<double, N> samples;
+    size_t next_index;
+    size_t count;
+};
+
+#endif // GIO_SAMPLE_RING_H
@@ -0,0 +1,102 @@
+#ifndef GIO_SPAN_H
+#define GIO_SPAN_H
+
+#include <cstddef>
+
+namespace gio
+{
+    /**
+     * @brief A non-owning view of a contiguous run of elements, standing in for std::span while the
+     * project builds as C++17. A span can be made from a pointer and a count, a built-in array, or any
+     * container with data() and size(), such as std::vector and std::array
+     * @tparam T the element type, which is const for a read-only view
+     */
+    template <typename T>
+    class Span
+    {
+    public:
+        /**
+         * @brief constructs an empty span
+         */
+        constexpr Span() :
+            elements(nullptr),
+            count(0)
+        {
+            // Empty Constructor
+        }
+
+        /**
+         * @brief constructs a span over the given elements
+         * @param elements the first element
+         * @param count the number of elements
+         */
+        constexpr Span(
+            T* elements,
+            const size_t count) :
+            elements(elements),
+            count(count)
+        {
+            // Empty Constructor
+        }
+
+        /**
+         * @brief constructs a span over a built-in array
+         * @param array the array to view
+         */
+        template <size_t N>
+        constexpr Span(T (&array)[N]) :
+            elements(array),
+            count(N)
+        {
+            // Empty Constructor
+        }
+
+        /**
+         * @brief constructs a span over the contents of a container
+         * @param container the container to view, which must outlive the span
+         */
+        template <typename Container>
+        constexpr Span(Container& container) :
+            elements(container.data()),
+            count(container.size())
+        {
+            // Empty Constructor
+        }
+
+        constexpr T* data() const
+        {
+            return elements;
+        }
+
+        constexpr size_t size() const
+        {
+            return count;
+        }
+
+        constexpr bool empty() const
+        {
+            return count == 0;
+        }
+
+        constexpr T& operator[](const size_t i) const
+        {
+            return elements[i];
+        }
+
+        constexpr T* begin() const
+        {
+            return elements;
+        }
+
+        constexpr T* end() const
+        {
+            return elements + count;
+        }
+
+    protected:
+        T* elements;
+        size_t count;
+    };
+}
+
+#endif // GIO_SPAN_H
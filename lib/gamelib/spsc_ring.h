@@ -0,0 +1,80 @@
+#ifndef GIO_SPSC_RING_H
+#define GIO_SPSC_RING_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+/**
+ * @brief A lock-free single-producer, single-consumer queue in a fixed-size ring. The writer pushes
+ * values in order and the reader pops them in the same order, so unlike the TripleBuffer no value is
+ * skipped while the reader keeps up. Neither side ever waits on the other, and a push fails rather
+ * than overwriting a value that has not been read once the ring is full
+ * @tparam T the value type, which must be default constructible and copyable
+ * @tparam N the number of values held, as a power of two
+ */
+template <typename T, size_t N>
+class SpscRing
+{
+public:
+    static_assert(N > 0 && (N & (N - 1)) == 0, "spsc rings must hold a power of two values");
+
+    /**
+     * @brief constructs an empty ring
+     */
+    SpscRing() :
+        write_count(0),
+        read_count(0)
+    {
+        // Empty Constructor
+    }
+
+    SpscRing(const SpscRing&) = delete;
+    SpscRing& operator=(const SpscRing&) = delete;
+
+    /**
+     * @brief adds a value after the values already held, to be called by the writer only
+     * @param value the value to add
+     * @return true if added, or false if the ring is full
+     */
+    bool push(const T& value)
+    {
+        const size_t written = write_count.load(std::memory_order_relaxed);
+        if (written - read_count.load(std::memory_order_acquire) >= N)
+        {
+            return false;
+        }
+
+        values[written & INDEX_MASK] = value;
+        write_count.store(written + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief removes the oldest value held, to be called by the reader only
+     * @param value set to the removed value
+     * @return true if a value was removed, or false if the ring is empty
+     */
+    bool pop(T& value)
+    {
+        const size_t read = read_count.load(std::memory_order_relaxed);
+        if (read == write_count.load(std::memory_order_acquire))
+        {
+            return false;
+        }
+
+        value = values[read & INDEX_MASK];
+        read_count.store(read + 1, std::memory_order_release);
+        return true;
+    }
+
+protected:
+    static const size_t INDEX_MASK = N - 1;
+
+    std::array<T, N> values;
+
+    std::atomic<size_t> write_count;
+    std::atomic<size_t> read_count;
+};
+
+#endif // GIO_SPSC_RING_H
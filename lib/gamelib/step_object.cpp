@@ -2,27 +2,7 @@
 
 StepState::StepState() :
     time_step(0.0),
-    input_manager(nullptr)
+    input(nullptr)
 {
     // Empty Constructor
 }
-
-StepState::~StepState()
-{
-    // Do Nothing;
-}
-
-void StepObject::pre_step(const StepState*)
-{
-    // Do Nothing
-}
-
-void StepObject::step(const StepState*)
-{
-    // Do Nothing
-}
-
-void StepObject::post_step(const StepState*)
-{
-    // Do Nothing
-}
@@ -1,7 +1,9 @@
 #ifndef GIO_STEP_OBJECT_H
 #define GIO_STEP_OBJECT_H
 
-#include <gamelib/input_manager.h>
+#include <gamelib/input_snapshot.h>
+
+#include <type_traits>
 
 /**
  * @brief Provides the basic state information for a given step
@@ -11,37 +13,72 @@ struct StepState
 public:
     double time_step;
 
-    InputManager* input_manager;
+    const InputSnapshot* input;
 
 public:
     StepState();
-
-    virtual ~StepState();
 };
 
 /**
  * @brief Provides the base object for a steppable object
+ * @tparam StateType the step state type passed to each step function, which is fixed at
+ * compile time so that objects never need to check the state type while stepping
  */
+template <typename StateType>
 class StepObject
 {
+    static_assert(std::is_base_of<StepState, StateType>::value, "step objects must use a StepState-derived state");
+
 public:
+    /**
+     * @brief the step state type used by the object
+     */
+    using State = StateType;
+
     /**
      * @brief function to run right before the step
      * @param state is the state to use for the step computation
      */
-    virtual void pre_step(const StepState* state);
+    virtual void pre_step(const StateType*)
+    {
+        // Do Nothing
+    }
+
+    /**
+     * @brief function to apply forces and moments for the current physics body state. Multi-stage
+     * integrators call this several times within a single step, so it must not advance any other state
+     * @param state is the state to use for the step computation
+     */
+    virtual void apply_forces(const StateType*)
+    {
+        // Do Nothing
+    }
 
     /**
      * @brief function to run to perform the step
      * @param state is the state to use for the step computation
      */
-    virtual void step(const StepState* state);
+    virtual void step(const StateType*)
+    {
+        // Do Nothing
+    }
 
     /**
      * @brief function to run right after the step
      * @param state is the state to use for the step computation
      */
-    virtual void post_step(const StepState* state);
+    virtual void post_step(const StateType*)
+    {
+        // Do Nothing
+    }
+
+    /**
+     * @brief virtual destructor
+     */
+    virtual ~StepObject()
+    {
+        // Empty Destructor
+    }
 };
 
 #endif // GIO_STEP_OBJECT_H
@@ -0,0 +1,376 @@
+#include <gamelib/trace.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    /**
+     * @brief the number of events held by each thread ring, which must be a power of two
+     */
+    const size_t RING_CAPACITY = 1 << 15;
+
+    /**
+     * @brief the time between drains of the thread rings
+     */
+    const std::chrono::milliseconds FLUSH_INTERVAL(20);
+
+    /**
+     * @brief a single recorded event
+     */
+    struct TraceEvent
+    {
+        const char* name;
+        uint64_t start_ns;
+        uint64_t end_ns;
+        bool instant;
+    };
+
+    /**
+     * @brief the events recorded by a single thread, written only by that thread and read only by the
+     * flush thread, with each side owning one of the indices
+     */
+    struct ThreadRing
+    {
+        explicit ThreadRing(const uint32_t thread_id) :
+            thread_id(thread_id),
+            thread_name(nullptr),
+            write_index(0),
+            read_index(0),
+            events(new TraceEvent[RING_CAPACITY])
+        {
+            // Empty Constructor
+        }
+
+        const uint32_t thread_id;
+        std::atomic<const char*> thread_name;
+
+        std::atomic<size_t> write_index;
+        std::atomic<size_t> read_index;
+
+        std::unique_ptr<TraceEvent[]> events;
+    };
+
+    /**
+     * @brief the state shared by every thread while tracing
+     */
+    struct TraceSession
+    {
+        /**
+         * @brief finishes any trace still running at exit, so that the file is complete
+         */
+        ~TraceSession()
+        {
+            stop();
+        }
+
+        /**
+         * @brief stops the flush thread, writes any remaining events and closes the file
+         */
+        void stop();
+
+        std::atomic<bool> active{ false };
+        std::atomic<uint64_t> dropped_count{ 0 };
+        uint64_t start_ns = 0;
+
+        // Guards the ring list, which only grows, and the file
+        std::mutex mutex;
+        std::vector<std::unique_ptr<ThreadRing>> rings;
+        std::ofstream file;
+        bool first_record = true;
+
+        std::mutex flush_mutex;
+        std::condition_variable flush_condition;
+        bool flush_stop = false;
+        std::thread flush_thread;
+    };
+
+    TraceSession& session()
+    {
+        static TraceSession instance;
+        return instance;
+    }
+
+    /**
+     * @brief provides the ring of the calling thread, registering it on first use
+     */
+    ThreadRing& thread_ring()
+    {
+        thread_local ThreadRing* ring = nullptr;
+
+        if (ring == nullptr)
+        {
+            TraceSession& trace = session();
+            std::lock_guard<std::mutex> lock(trace.mutex);
+
+            trace.rings.push_back(std::make_unique<ThreadRing>(static_cast<uint32_t>(trace.rings.size() + 1)));
+            ring = trace.rings.back().get();
+        }
+
+        return *ring;
+    }
+
+    /**
+     * @brief adds an event to the ring of the calling thread, dropping it if the ring is full
+     */
+    void push_event(const TraceEvent& event)
+    {
+        ThreadRing& ring = thread_ring();
+
+        const size_t write_index = ring.write_index.load(std::memory_order_relaxed);
+        if (write_index - ring.read_index.load(std::memory_order_acquire) >= RING_CAPACITY)
+        {
+            session().dropped_count.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        ring.events[write_index & (RING_CAPACITY - 1)] = event;
+        ring.write_index.store(write_index + 1, std::memory_order_release);
+    }
+
+    /**
+     * @brief writes the separator before each record after the first, with the lock held
+     */
+    void begin_record(TraceSession& trace)
+    {
+        if (!trace.first_record)
+        {
+            trace.file << ",\n";
+        }
+
+        trace.first_record = false;
+    }
+
+    /**
+     * @brief writes a string as a JSON string value, escaping any quotes, backslashes and control characters
+     */
+    void write_json_string(
+        std::ofstream& file,
+        const char* text)
+    {
+        file << '"';
+
+        for (const char* c = text; *c != '\0'; ++c)
+        {
+            if (*c == '"' || *c == '\\')
+            {
+                file << '\\' << *c;
+            }
+            else if (static_cast<unsigned char>(*c) < 0x20)
+            {
+                char escaped[8];
+                std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned int>(*c));
+                file << escaped;
+            }
+            else
+            {
+                file << *c;
+            }
+        }
+
+        file << '"';
+    }
+
+    /**
+     * @brief writes a thread name record, with the lock held
+     */
+    void write_thread_name(
+        TraceSession& trace,
+        const ThreadRing& ring,
+        const char* name)
+    {
+        begin_record(trace);
+        trace.file << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << ring.thread_id << ",\"args\":{\"name\":";
+        write_json_string(trace.file, name);
+        trace.file << "}}";
+    }
+
+    /**
+     * @brief writes every event recorded since the last drain, with the lock held
+     */
+    void drain_rings(TraceSession& trace)
+    {
+        char times[96];
+
+        for (const std::unique_ptr<ThreadRing>& ring : trace.rings)
+        {
+            const size_t read_index = ring->read_index.load(std::memory_order_relaxed);
+            const size_t write_index = ring->write_index.load(std::memory_order_acquire);
+
+            for (size_t i = read_index; i != write_index; ++i)
+            {
+                const TraceEvent& event = ring->events[i & (RING_CAPACITY - 1)];
+
+                // Events recorded before the trace started are left out
+                if (event.start_ns < trace.start_ns)
+                {
+                    continue;
+                }
+
+                const double start_us = static_cast<double>(event.start_ns - trace.start_ns) / 1000.0;
+
+                begin_record(trace);
+                trace.file << "{\"name\":";
+                write_json_string(trace.file, event.name);
+
+                if (event.instant)
+                {
+                    std::snprintf(times, sizeof(times), ",\"ph\":\"i\",\"s\":\"t\",\"ts\":%.3f", start_us);
+                }
+                else
+                {
+                    const double duration_us = static_cast<double>(event.end_ns - event.start_ns) / 1000.0;
+                    std::snprintf(times, sizeof(times), ",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f", start_us, duration_us);
+                }
+
+                trace.file << times << ",\"pid\":1,\"tid\":" << ring->thread_id << "}";
+            }
+
+            ring->read_index.store(write_index, std::memory_order_release);
+        }
+    }
+
+    void TraceSession::stop()
+    {
+        if (!flush_thread.joinable())
+        {
+            return;
+        }
+
+        active = false;
+
+        {
+            std::lock_guard<std::mutex> flush_lock(flush_mutex);
+            flush_stop = true;
+        }
+
+        flush_condition.notify_one();
+        flush_thread.join();
+
+        // Write anything recorded since the last drain, and close the file
+        std::lock_guard<std::mutex> lock(mutex);
+        drain_rings(*this);
+
+        file << "\n]}\n";
+        file.close();
+    }
+
+    /**
+     * @brief the loop run by the flush thread, draining the rings at a fixed interval until stopped
+     */
+    void flush_loop()
+    {
+        TraceSession& trace = session();
+
+        std::unique_lock<std::mutex> flush_lock(trace.flush_mutex);
+        while (!trace.flush_stop)
+        {
+            trace.flush_condition.wait_for(flush_lock, FLUSH_INTERVAL);
+
+            std::lock_guard<std::mutex> lock(trace.mutex);
+            drain_rings(trace);
+        }
+    }
+}
+
+namespace gio
+{
+    bool start_trace(const std::string& path)
+    {
+        stop_trace();
+
+        TraceSession& trace = session();
+
+        {
+            std::lock_guard<std::mutex> lock(trace.mutex);
+
+            trace.file.open(path);
+            if (!trace.file)
+            {
+                return false;
+            }
+
+            trace.file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+            trace.first_record = true;
+            trace.start_ns = trace_clock_ns();
+            trace.dropped_count = 0;
+
+            // Skip any events left from a previous trace, and name the threads already known
+            for (const std::unique_ptr<ThreadRing>& ring : trace.rings)
+            {
+                ring->read_index.store(ring->write_index.load(std::memory_order_acquire), std::memory_order_release);
+
+                const char* name = ring->thread_name.load();
+                if (name != nullptr)
+                {
+                    write_thread_name(trace, *ring, name);
+                }
+            }
+        }
+
+        trace.flush_stop = false;
+        trace.flush_thread = std::thread(flush_loop);
+        trace.active = true;
+
+        return true;
+    }
+
+    void stop_trace()
+    {
+        session().stop();
+    }
+
+    bool trace_active()
+    {
+        return session().active.load(std::memory_order_relaxed);
+    }
+
+    uint64_t get_trace_dropped_count()
+    {
+        return session().dropped_count.load();
+    }
+
+    uint64_t trace_clock_ns()
+    {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+    void trace_complete(
+        const char* name,
+        const uint64_t start_ns,
+        const uint64_t end_ns)
+    {
+        push_event({ name, start_ns, end_ns, false });
+    }
+
+    void trace_instant(const char* name)
+    {
+        if (trace_active())
+        {
+            const uint64_t now_ns = trace_clock_ns();
+            push_event({ name, now_ns, now_ns, true });
+        }
+    }
+
+    void set_trace_thread_name(const char* name)
+    {
+        ThreadRing& ring = thread_ring();
+        ring.thread_name = name;
+
+        // Name the thread in a running trace straight away, or when the next trace starts otherwise
+        TraceSession& trace = session();
+        if (trace.active)
+        {
+            std::lock_guard<std::mutex> lock(trace.mutex);
+            write_thread_name(trace, ring, name);
+        }
+    }
+}
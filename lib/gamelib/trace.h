@@ -0,0 +1,116 @@
+#ifndef GIO_TRACE_H
+#define GIO_TRACE_H
+
+#include <cstdint>
+#include <string>
+
+/**
+ * @brief Records timed scopes into a Chrome trace_event JSON file, which can be opened in
+ * chrome://tracing or Perfetto to find rare hitches in long runs. Each thread records into its own
+ * fixed-size lock-free ring, which a background thread drains into the file while the trace is running,
+ * so that recording never blocks or allocates once a thread has recorded its first event. Events are
+ * dropped and counted if a ring fills faster than it is drained.
+ *
+ * The GIO_TRACE_* macros compile to nothing unless GIO_TRACE is defined, which the CMake option
+ * GIO_ENABLE_TRACING does, and otherwise only check a flag until a trace is started. Event names must
+ * be string literals or otherwise outlive the trace
+ */
+namespace gio
+{
+    /**
+     * @brief starts writing a trace, stopping any trace already running
+     * @param path the JSON file to write
+     * @return true if the file was opened
+     */
+    bool start_trace(const std::string& path);
+
+    /**
+     * @brief stops the trace, writing any remaining events and closing the file
+     */
+    void stop_trace();
+
+    /**
+     * @brief determines if a trace is running
+     * @return true if events are being recorded
+     */
+    bool trace_active();
+
+    /**
+     * @brief provides the number of events dropped so far because a thread ring was full
+     * @return the dropped event count
+     */
+    uint64_t get_trace_dropped_count();
+
+    /**
+     * @brief provides the trace clock, which is the steady clock in nanoseconds
+     * @return the current time
+     */
+    uint64_t trace_clock_ns();
+
+    /**
+     * @brief records a completed scope on the calling thread
+     * @param name the event name
+     * @param start_ns the trace clock time when the scope started
+     * @param end_ns the trace clock time when the scope ended
+     */
+    void trace_complete(
+        const char* name,
+        const uint64_t start_ns,
+        const uint64_t end_ns);
+
+    /**
+     * @brief records an instant event on the calling thread
+     * @param name the event name
+     */
+    void trace_instant(const char* name);
+
+    /**
+     * @brief names the calling thread in the trace
+     * @param name the thread name
+     */
+    void set_trace_thread_name(const char* name);
+
+    /**
+     * @brief records the time from its construction to its destruction as a trace event
+     */
+    class TraceScope
+    {
+    public:
+        explicit TraceScope(const char* name) :
+            name(trace_active() ? name : nullptr),
+            start_ns(this->name != nullptr ? trace_clock_ns() : 0)
+        {
+            // Empty Constructor
+        }
+
+        ~TraceScope()
+        {
+            if (name != nullptr)
+            {
+                trace_complete(name, start_ns, trace_clock_ns());
+            }
+        }
+
+        TraceScope(const TraceScope&) = delete;
+        TraceScope& operator=(const TraceScope&) = delete;
+
+    protected:
+        const char* name;
+        uint64_t start_ns;
+    };
+}
+
+#define GIO_TRACE_CONCAT_INNER(a, b) a##b
+#define GIO_TRACE_CONCAT(a, b) GIO_TRACE_CONCAT_INNER(a, b)
+
+#ifdef GIO_TRACE
+#define GIO_TRACE_SCOPE(name) const gio::TraceScope GIO_TRACE_CONCAT(gio_trace_scope_, __LINE__)(name)
+#define GIO_TRACE_INSTANT(name) gio::trace_instant(name)
+#define GIO_TRACE_THREAD_NAME(name) gio::set_trace_thread_name(name)
+#else
+#define GIO_TRACE_SCOPE(name) static_cast<void>(0)
+#define GIO_TRACE_INSTANT(name) static_cast<void>(0)
+#define GIO_TRACE_THREAD_NAME(name) static_cast<void>(0)
+#endif
+
+#endif // GIO_TRACE_H
@@ -0,0 +1,85 @@
+#ifndef GIO_TRIPLE_BUFFER_H
+#define GIO_TRIPLE_BUFFER_H
+
+#include <atomic>
+#include <cstdint>
+
+/**
+ * @brief A lock-free single-producer, single-consumer triple buffer. The writer fills its back buffer
+ * and publishes it by swapping it with the shared middle buffer, and the reader picks up the newest
+ * published buffer by swapping its front buffer with the middle buffer. Neither side ever waits on the
+ * other, the reader always sees a complete buffer, and buffers published between two reads are skipped
+ * @tparam T the buffer type, which must be default constructible
+ */
+template <typename T>
+class TripleBuffer
+{
+public:
+    /**
+     * @brief constructs the buffers with default values
+     */
+    TripleBuffer() :
+        write_index(0),
+        shared_state(1),
+        read_index(2)
+    {
+        // Empty Constructor
+    }
+
+    TripleBuffer(const TripleBuffer&) = delete;
+    TripleBuffer& operator=(const TripleBuffer&) = delete;
+
+    /**
+     * @brief provides the buffer owned by the writer, to be filled before calling publish
+     * @return the writer buffer
+     */
+    T& write_buffer()
+    {
+        return buffers[write_index];
+    }
+
+    /**
+     * @brief publishes the writer buffer as the newest value, and takes over the previous middle buffer
+     * as the next writer buffer
+     */
+    void publish()
+    {
+        write_index = shared_state.exchange(static_cast<uint8_t>(write_index | FRESH_FLAG), std::memory_order_acq_rel) & INDEX_MASK;
+    }
+
+    /**
+     * @brief takes over the newest published buffer if one has been published since the last update
+     * @return true if the reader buffer now holds a newer value
+     */
+    bool update()
+    {
+        if ((shared_state.load(std::memory_order_relaxed) & FRESH_FLAG) == 0)
+        {
+            return false;
+        }
+
+        read_index = shared_state.exchange(read_index, std::memory_order_acq_rel) & INDEX_MASK;
+        return true;
+    }
+
+    /**
+     * @brief provides the buffer owned by the reader
+     * @return the reader buffer
+     */
+    const T& read_buffer() const
+    {
+        return buffers[read_index];
+    }
+
+protected:
+    static const uint8_t INDEX_MASK = 0x03;
+    static const uint8_t FRESH_FLAG = 0x04;
+
+    T buffers[3];
+
+    uint8_t write_index;
+    std::atomic<uint8_t> shared_state;
+    uint8_t read_index;
+};
+
+#endif // GIO_TRIPLE_BUFFER_H
@@ -1,6 +1,54 @@
 #ifndef GIO_VECTOR2_H
 #define GIO_VECTOR2_H
 
+#include <cmath>
+
+#include <gamelib/constants.h>
+
+/**
+ * @brief a precomputed sine and cosine pair, allowing many vectors to be rotated
+ * by the same angle without recomputing the trigonometric functions
+ */
+struct SinCos
+{
+    /**
+     * @brief constructs the pair from already-computed values
+     * @param sin_val the sine of the angle
+     * @param cos_val the cosine of the angle
+     */
+    constexpr SinCos(
+        const double sin_val,
+        const double cos_val) :
+        sin(sin_val),
+        cos(cos_val)
+    {
+        // Empty Constructor
+    }
+
+    /**
+     * @brief computes the pair for the given angle
+     * @param angle the angle to use, in radians
+     */
+    explicit SinCos(const double angle) :
+        sin(std::sin(angle)),
+        cos(std::cos(angle))
+    {
+        // Empty Constructor
+    }
+
+    /**
+     * @brief provides the pair for the negated angle
+     * @return the inverse rotation pair
+     */
+    constexpr SinCos inverse() const
+    {
+        return SinCos(-sin, cos);
+    }
+
+    double sin;
+    double cos;
+};
+
 /**
  * @brief a 2D vector library
  */
@@ -10,131 +58,223 @@ public:
     /**
      * @brief constructs a Vector2 object with (0, 0)
      */
-    Vector2();
+    constexpr Vector2() :
+        x(0.0),
+        y(0.0)
+    {
+        // Empty Constructor
+    }
 
     /**
      * @brief constructs a Vector 2 with (x, y)
      * @param x is the x coordinate to use
      * @param y is the y coordinate to use
      */
-    explicit Vector2(
+    constexpr explicit Vector2(
         const double x,
-        const double y);
+        const double y) :
+        x(x),
+        y(y)
+    {
+        // Empty Constructor
+    }
 
     /**
      * @brief computes the dot product of two vectors
      * @param other the second vector operand in the dot product
      * @return the resulting dot product
      */
-    double dot(const Vector2& other) const;
+    constexpr double dot(const Vector2& other) const
+    {
+        return x * other.x + y * other.y;
+    }
 
     /**
      * @brief computes the cross product of two vectors
      * @param other the second vector operand in the cross product
      * @return the result of this cross other
      */
-    double cross(const Vector2& other) const;
+    constexpr double cross(const Vector2& other) const
+    {
+        return x * other.y - y * other.x;
+    }
 
     /**
      * @brief computes the vector magnitude
      * @return the vector magnitude
      */
-    double magnitude() const;
+    double magnitude() const
+    {
+        return std::sqrt(magnitude_squared());
+    }
 
     /**
      * @brief computes the vector magnitude squared
      * @return the squared vector magnitude
      */
-    double magnitude_squared() const;
+    constexpr double magnitude_squared() const
+    {
+        return x * x + y * y;
+    }
 
     /**
      * @brief rotates the vector for the given angle
      * @param angle the amount to rotate the vector by, in radians
      * @return a new rotated vector
      */
-    Vector2 rotate_rad(const double angle) const;
+    Vector2 rotate_rad(const double angle) const
+    {
+        return rotate_rad(SinCos(angle));
+    }
+
+    /**
+     * @brief rotates the vector for a precomputed angle
+     * @param angle the sine and cosine of the angle to rotate the vector by
+     * @return a new rotated vector
+     */
+    constexpr Vector2 rotate_rad(const SinCos& angle) const
+    {
+        return Vector2(
+            x * angle.cos + -y * angle.sin,
+            x * angle.sin + y * angle.cos);
+    }
 
     /**
      * @brief rotates the vector for the given angle
      * @param angle the amount to rotate the vector by, in degrees
      * @return a new rotated vector
      */
-    Vector2 rotate_deg(const double angle) const;
+    Vector2 rotate_deg(const double angle) const
+    {
+        return rotate_rad(angle * gio::pi / 180.0);
+    }
 
     /**
      * @brief computes the vector norm
      * @return the normalized version of the current vector
      */
-    Vector2 normalize() const;
+    Vector2 normalize() const
+    {
+        const double mag = magnitude();
+        return Vector2(
+            x / mag,
+            y / mag);
+    }
 
     /**
      * @brief computes the result of adding two vectors together
      * @param other the second operand in the addition operation
      * @return a new vector resulting in the element-wise summation
      */
-    Vector2 operator+(const Vector2& other) const;
+    constexpr Vector2 operator+(const Vector2& other) const
+    {
+        return Vector2(
+            x + other.x,
+            y + other.y);
+    }
 
     /**
      * @brief computes the result of adding two vectors together
      * @param other the second operand in the addition operation
      * @return a reference to the current vector with the operation completed
      */
-    Vector2& operator+=(const Vector2& other);
+    constexpr Vector2& operator+=(const Vector2& other)
+    {
+        x += other.x;
+        y += other.y;
+        return *this;
+    }
 
     /**
      * @brief computes the result of adding a scalar
      * @param other the second operand in the addition operation
      * @return a reference to the current vector with the operation completed
      */
-    Vector2& operator+=(const double val);
+    constexpr Vector2& operator+=(const double val)
+    {
+        x += val;
+        y += val;
+        return *this;
+    }
 
     /**
      * @brief negates the current vector
      * @return a new vector with negated values
      */
-    Vector2 operator-() const;
+    constexpr Vector2 operator-() const
+    {
+        return Vector2(
+            -x,
+            -y);
+    }
 
     /**
      * @brief computes the result of subtracting two vectors together
      * @param other the second operand in the subtraction operation
      * @return a reference to the current vector with the operation completed
      */
-    Vector2 operator-(const Vector2& other) const;
+    constexpr Vector2 operator-(const Vector2& other) const
+    {
+        return Vector2(
+            x - other.x,
+            y - other.y);
+    }
 
     /**
      * @brief computes the result of subtracting two vectors together
      * @param other the second operand in the subtracting operation
      * @return a reference to the current vector with the operation completed
      */
-    Vector2& operator-=(const Vector2& other);
+    constexpr Vector2& operator-=(const Vector2& other)
+    {
+        *this += -other;
+        return *this;
+    }
 
     /**
      * @brief computes the result of subtracting a scalar
      * @param other the second operand in the subtraction operation
      * @return a reference to the current vector with the operation completed
      */
-    Vector2& operator-=(const double val);
+    constexpr Vector2& operator-=(const double val)
+    {
+        *this += -val;
+        return *this;
+    }
 
     /**
      * @brief computes the result of multiplying by a scalar
      * @param other the second operand in the multiplication operation
      * @return a reference to the current vector with the operation completed
      */
-    Vector2& operator*=(const double val);
+    constexpr Vector2& operator*=(const double val)
+    {
+        x *= val;
+        y *= val;
+        return *this;
+    }
 
     /**
      * @brief computes the result of dividing by a scalar
      * @param other the second operand in the division operation
      * @return a reference to the current vector with the operation completed
      */
-    Vector2& operator/=(const double val);
+    constexpr Vector2& operator/=(const double val)
+    {
+        x /= val;
+        y /= val;
+        return *this;
+    }
 
     /**
      * @brief computes the distance to the other vector
      * @param other the vector to compute distance to
      * @return the distnace to the other vector
      */
-    double distance_to(const Vector2& other) const;
+    double distance_to(const Vector2& other) const
+    {
+        return (*this - other).magnitude();
+    }
 
 public:
     double x;
@@ -147,7 +287,12 @@ public:
  * @param vec the vector value
  * @return a new vector with the scalar added to the vector
  */
-Vector2 operator+(const double val, const Vector2& vec);
+constexpr Vector2 operator+(const double val, const Vector2& vec)
+{
+    return Vector2(
+        val + vec.x,
+        val + vec.y);
+}
 
 /**
  * @brief addition of a vector and a scalar
@@ -155,7 +300,12 @@ Vector2 operator+(const double val, const Vector2& vec);
  * @param val the scalar value
  * @return a new vector with the scalar added to the vector
  */
-Vector2 operator+(const Vector2& vec, const double val);
+constexpr Vector2 operator+(const Vector2& vec, const double val)
+{
+    return Vector2(
+        vec.x + val,
+        vec.y + val);
+}
 
 /**
  * @brief subtraction of a vector from a scalar
@@ -163,7 +313,10 @@ Vector2 operator+(const Vector2& vec, const double val);
  * @param vec the vector value
  * @return a new vector with the vector subtracted from the scalar
  */
-Vector2 operator-(const double val, const Vector2& vec);
+constexpr Vector2 operator-(const double val, const Vector2& vec)
+{
+    return val + -vec;
+}
 
 /**
  * @brief subtraction of a scalar from a vector
@@ -171,7 +324,10 @@ Vector2 operator-(const double val, const Vector2& vec);
  * @param val the scalar value
  * @return a new vector with thes scalar subtracted from the vector
  */
-Vector2 operator-(const Vector2& vec, const double val);
+constexpr Vector2 operator-(const Vector2& vec, const double val)
+{
+    return vec + -val;
+}
 
 /**
  * @brief multiplication of a vector and a scalar
@@ -179,7 +335,12 @@ Vector2 operator-(const Vector2& vec, const double val);
  * @param val the scalar value
  * @return a new vector with the scalar multiplied to the vector
  */
-Vector2 operator*(const Vector2& vec, const double val);
+constexpr Vector2 operator*(const Vector2& vec, const double val)
+{
+    return Vector2(
+        vec.x * val,
+        vec.y * val);
+}
 
 /**
  * @brief multiplication of a vector and a scalar
@@ -187,7 +348,10 @@ Vector2 operator*(const Vector2& vec, const double val);
  * @param vec the vector value 
  * @return a new vector with the scalar multiplied to the vector
  */
-Vector2 operator*(const double val, const Vector2& vec);
+constexpr Vector2 operator*(const double val, const Vector2& vec)
+{
+    return vec * val;
+}
 
 /**
  * @brief division of a vector by a scalar
@@ -195,7 +359,10 @@ Vector2 operator*(const double val, const Vector2& vec);
  * @param val the scalar value
  * @return a new vector with the vector divided by the scalar
  */
-Vector2 operator/(const Vector2& vec, const double val);
+constexpr Vector2 operator/(const Vector2& vec, const double val)
+{
+    return vec * (1.0 / val);
+}
 
 /**
  * @brief division of a scalar by a vector
@@ -203,6 +370,9 @@ Vector2 operator/(const Vector2& vec, const double val);
  * @param vec the vector value
  * @return a new vector with the scalar divided by the vector
  */
-Vector2 operator/(const double val, const Vector2& vec);
+constexpr Vector2 operator/(const double val, const Vector2& vec)
+{
+    return (1.0 / val) * vec;
+}
 
 #endif // GIO_VECTOR2_H
@@ -0,0 +1,203 @@
+#include <gamelib/work_stealing_pool.h>
+
+#include <algorithm>
+
+WorkStealingPool::WorkStealingPool(const size_t thread_count) :
+    batch_generation(0),
+    busy_workers(0),
+    stopping(false),
+    current_task(nullptr),
+    steal_count(0)
+{
+    // Determine the number of threads, falling back to a single thread if the core count is unknown
+    size_t count = thread_count;
+    if (count == 0)
+    {
+        count = std::max<size_t>(1, std::thread::hardware_concurrency());
+    }
+
+    // Create one queue per thread, where the calling thread owns the first queue
+    for (size_t i = 0; i < count; ++i)
+    {
+        queues.push_back(std::make_unique<TaskQueue>());
+    }
+
+    for (size_t i = 1; i < count; ++i)
+    {
+        threads.emplace_back(&WorkStealingPool::worker_loop, this, i);
+    }
+}
+
+WorkStealingPool::~WorkStealingPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(batch_mutex);
+        stopping = true;
+    }
+
+    batch_started.notify_all();
+
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+}
+
+size_t WorkStealingPool::get_thread_count() const
+{
+    return queues.size();
+}
+
+size_t WorkStealingPool::get_last_steal_count() const
+{
+    return steal_count.load();
+}
+
+void WorkStealingPool::run(
+    const size_t task_count,
+    const TaskFunction& task)
+{
+    // Split the tasks into contiguous blocks, one per queue
+    const size_t queue_count = queues.size();
+
+    for (size_t q = 0; q < queue_count; ++q)
+    {
+        const size_t begin = task_count * q / queue_count;
+        const size_t end = task_count * (q + 1) / queue_count;
+
+        std::lock_guard<std::mutex> lock(queues[q]->mutex);
+        for (size_t i = begin; i < end; ++i)
+        {
+            queues[q]->tasks.push_back(i);
+        }
+    }
+
+    // Wake the background workers for the new batch
+    {
+        std::lock_guard<std::mutex> lock(batch_mutex);
+        current_task = &task;
+        first_exception = nullptr;
+        steal_count = 0;
+        busy_workers = threads.size();
+        ++batch_generation;
+    }
+
+    batch_started.notify_all();
+
+    // Work on the batch from the calling thread as well, and then wait for the other workers to finish
+    drain_queues(0);
+
+    std::unique_lock<std::mutex> lock(batch_mutex);
+    batch_finished.wait(lock, [this]() { return busy_workers == 0; });
+
+    current_task = nullptr;
+
+    if (first_exception)
+    {
+        std::rethrow_exception(first_exception);
+    }
+}
+
+void WorkStealingPool::worker_loop(const size_t queue_index)
+{
+    size_t seen_generation = 0;
+
+    while (true)
+    {
+        // Wait for a new batch or for the pool to stop
+        {
+            std::unique_lock<std::mutex> lock(batch_mutex);
+            batch_started.wait(lock, [this, seen_generation]() { return stopping || batch_generation != seen_generation; });
+
+            if (stopping)
+            {
+                return;
+            }
+
+            seen_generation = batch_generation;
+        }
+
+        drain_queues(queue_index);
+
+        // Report that this worker has finished the batch
+        bool last_worker = false;
+        {
+            std::lock_guard<std::mutex> lock(batch_mutex);
+            last_worker = (--busy_workers == 0);
+        }
+
+        if (last_worker)
+        {
+            batch_finished.notify_all();
+        }
+    }
+}
+
+void WorkStealingPool::drain_queues(const size_t queue_index)
+{
+    // No tasks are added once a batch has started, so every queue being empty means the batch is
+    // fully claimed
+    size_t task_index = 0;
+
+    while (pop_local(queue_index, task_index) || steal(queue_index, task_index))
+    {
+        run_task(task_index);
+    }
+}
+
+bool WorkStealingPool::pop_local(
+    const size_t queue_index,
+    size_t& task_index)
+{
+    TaskQueue& queue = *queues[queue_index];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+
+    if (queue.tasks.empty())
+    {
+        return false;
+    }
+
+    task_index = queue.tasks.front();
+    queue.tasks.pop_front();
+    return true;
+}
+
+bool WorkStealingPool::steal(
+    const size_t queue_index,
+    size_t& task_index)
+{
+    // Visit the other queues starting with the next one, so that thieves spread across victims
+    const size_t queue_count = queues.size();
+
+    for (size_t offset = 1; offset < queue_count; ++offset)
+    {
+        TaskQueue& victim = *queues[(queue_index + offset) % queue_count];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+
+        if (!victim.tasks.empty())
+        {
+            task_index = victim.tasks.back();
+            victim.tasks.pop_back();
+            ++steal_count;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void WorkStealingPool::run_task(const size_t task_index)
+{
+    try
+    {
+        (*current_task)(task_index);
+    }
+    catch (...)
+    {
+        std::lock_guard<std::mutex> lock(batch_mutex);
+        if (!first_exception)
+        {
+            first_exception = std::current_exception();
+        }
+    }
+}
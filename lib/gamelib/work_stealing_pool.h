@@ -0,0 +1,130 @@
+#ifndef GIO_WORK_STEALING_POOL_H
+#define GIO_WORK_STEALING_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief A fixed pool of worker threads that runs batches of indexed tasks. Each batch is split into
+ * contiguous blocks, one per worker queue. Workers take tasks from the front of their own queue and,
+ * once it is empty, steal from the back of the other queues, so that uneven task costs still keep
+ * every core busy
+ */
+class WorkStealingPool
+{
+public:
+    /**
+     * @brief the function type run for each task index
+     */
+    using TaskFunction = std::function<void(size_t task_index)>;
+
+    /**
+     * @brief starts the worker threads
+     * @param thread_count the number of threads to run tasks on, including the calling thread, or zero
+     * to use one thread per hardware core
+     */
+    explicit WorkStealingPool(const size_t thread_count = 0);
+
+    /**
+     * @brief stops and joins the worker threads
+     */
+    ~WorkStealingPool();
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    /**
+     * @brief provides the number of threads that tasks are run on, including the calling thread
+     * @return the thread count
+     */
+    size_t get_thread_count() const;
+
+    /**
+     * @brief runs the task for each index in [0, task_count) across all threads, returning once every
+     * task has completed. If any task throws, the first exception is rethrown once the batch is done
+     * @param task_count the number of tasks to run
+     * @param task the function to run for each task index
+     */
+    void run(
+        const size_t task_count,
+        const TaskFunction& task);
+
+    /**
+     * @brief provides the number of tasks that were stolen from another queue during the last batch
+     * @return the stolen task count
+     */
+    size_t get_last_steal_count() const;
+
+protected:
+    /**
+     * @brief a queue of task indices owned by one thread
+     */
+    struct TaskQueue
+    {
+        std::mutex mutex;
+        std::deque<size_t> tasks;
+    };
+
+    /**
+     * @brief the loop run by each background worker thread
+     * @param queue_index the index of the queue owned by the worker
+     */
+    void worker_loop(const size_t queue_index);
+
+    /**
+     * @brief runs tasks from the owned queue and then from the other queues until every queue is empty
+     * @param queue_index the index of the queue owned by the calling thread
+     */
+    void drain_queues(const size_t queue_index);
+
+    /**
+     * @brief takes the next task from the front of the owned queue
+     * @param queue_index the index of the owned queue
+     * @param task_index set to the task taken
+     * @return true if a task was taken
+     */
+    bool pop_local(
+        const size_t queue_index,
+        size_t& task_index);
+
+    /**
+     * @brief takes a task from the back of any other queue
+     * @param queue_index the index of the queue owned by the calling thread
+     * @param task_index set to the task taken
+     * @return true if a task was taken
+     */
+    bool steal(
+        const size_t queue_index,
+        size_t& task_index);
+
+    /**
+     * @brief runs a single task, recording the first exception thrown
+     * @param task_index the task to run
+     */
+    void run_task(const size_t task_index);
+
+protected:
+    std::vector<std::unique_ptr<TaskQueue>> queues;
+    std::vector<std::thread> threads;
+
+    std::mutex batch_mutex;
+    std::condition_variable batch_started;
+    std::condition_variable batch_finished;
+    size_t batch_generation;
+    size_t busy_workers;
+    bool stopping;
+
+    const TaskFunction* current_task;
+    std::exception_ptr first_exception;
+    std::atomic<size_t> steal_count;
+};
+
+#endif // GIO_WORK_STEALING_POOL_H
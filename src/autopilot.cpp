@@ -0,0 +1,69 @@
+#include "autopilot.h"
+
+#include <gamelib/keycodes.h>
+
+Autopilot::Autopilot()
+{
+    // Empty Constructor
+}
+
+Autopilot::Autopilot(const AutopilotSettings& settings) :
+    settings(settings)
+{
+    // Empty Constructor
+}
+
+const AutopilotSettings& Autopilot::get_settings() const
+{
+    return settings;
+}
+
+void Autopilot::update(
+    const Balloon& balloon,
+    Terrain& terrain)
+{
+    // Determine position state parameters
+    const Vector2 gondola_pos = balloon.get_gondola().get_position();
+    const double height_agl = terrain.elevation_at_x(gondola_pos.x) - gondola_pos.y;
+    const double temp_percent = balloon.get_envelope().get_temp_ratio();
+
+    // Perform bang-bang control
+    if (height_agl < settings.low_agl)
+    {
+        input_manager.set_key_up(ALLEGRO_KEY_DOWN);
+
+        if (temp_percent < settings.climb_burner_on_temp)
+        {
+            input_manager.set_key_down(ALLEGRO_KEY_UP);
+        }
+        else if (temp_percent > settings.climb_burner_off_temp)
+        {
+            input_manager.set_key_up(ALLEGRO_KEY_UP);
+        }
+    }
+    else if (height_agl > settings.high_agl)
+    {
+        if (temp_percent < settings.descend_valve_off_temp)
+        {
+            input_manager.set_key_up(ALLEGRO_KEY_DOWN);
+        }
+        else if (temp_percent > settings.descend_valve_on_temp)
+        {
+            input_manager.set_key_down(ALLEGRO_KEY_DOWN);
+        }
+
+        if (temp_percent < settings.descend_burner_on_temp)
+        {
+            input_manager.set_key_down(ALLEGRO_KEY_UP);
+        }
+        else if (temp_percent > settings.descend_burner_off_temp)
+        {
+            input_manager.set_key_up(ALLEGRO_KEY_UP);
+        }
+    }
+}
+
+InputManager* Autopilot::get_input_manager()
+{
+    return &input_manager;
+}
@@ -0,0 +1,73 @@
+#ifndef AUTOPILOT_H
+#define AUTOPILOT_H
+
+#include <gamelib/input_manager.h>
+
+#include <balloon/balloon.h>
+
+#include <terrain.h>
+
+/**
+ * @brief Provides the thresholds used by the autopilot, in height above ground level and envelope
+ * temperature ratio
+ */
+struct AutopilotSettings
+{
+    double low_agl = 290.0;
+    double high_agl = 310.0;
+
+    double climb_burner_on_temp = 0.9;
+    double climb_burner_off_temp = 0.95;
+
+    double descend_valve_off_temp = 0.6;
+    double descend_valve_on_temp = 0.8;
+
+    double descend_burner_on_temp = 0.5;
+    double descend_burner_off_temp = 0.75;
+};
+
+/**
+ * @brief Provides a simple bang-bang altitude controller that flies the balloon by
+ * pressing keys on its own input manager
+ */
+class Autopilot
+{
+public:
+    /**
+     * @brief Constructs the autopilot with no keys pressed
+     */
+    Autopilot();
+
+    /**
+     * @brief Constructs the autopilot with no keys pressed and the given thresholds
+     * @param settings the thresholds to fly with
+     */
+    explicit Autopilot(const AutopilotSettings& settings);
+
+    /**
+     * @brief provides the thresholds used by the autopilot
+     * @return the autopilot settings
+     */
+    const AutopilotSettings& get_settings() const;
+
+    /**
+     * @brief Updates the autopilot key state for the current balloon state
+     * @param balloon the balloon to control
+     * @param terrain the terrain to hold altitude over
+     */
+    void update(
+        const Balloon& balloon,
+        Terrain& terrain);
+
+    /**
+     * @brief provides the input manager driven by the autopilot
+     * @return a pointer to the autopilot input manager
+     */
+    InputManager* get_input_manager();
+
+protected:
+    AutopilotSettings settings;
+    InputManager input_manager;
+};
+
+#endif // AUTOPILOT_H
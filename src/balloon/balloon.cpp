@@ -1,12 +1,18 @@
 #include "balloon.h"
 
+#include <gamelib/keycodes.h>
+
 #include <world_state.h>
 
 Balloon::Balloon() :
-    rope_1(100.0),
-    rope_2(100.0),
-    rope_3(100.0),
-    rope_4(100.0)
+    gondola(bodies),
+    envelope(bodies),
+    rope_1(100.0, 16),
+    rope_2(100.0, 16),
+    weight_1(bodies),
+    weight_2(bodies),
+    rope_3(100.0, 6),
+    rope_4(100.0, 6)
 {
     // Add each item to the objects list
     objects.push_back(&gondola);
@@ -40,9 +46,18 @@ void Balloon::set_position(const double x, const double y)
     envelope.set_position(x, y - envelope.get_radius() * 2.0);
 
     const Vector2 weight_offset(0.0, 30.0);
+    const GondolaCorners corners = gondola.get_corners();
 
-    weight_1.set_position(gondola.get_bottom_left() + weight_offset);
-    weight_2.set_position(gondola.get_bottom_right() + weight_offset);
+    weight_1.set_position(corners.points[GondolaCorners::BOTTOM_LEFT] + weight_offset);
+    weight_2.set_position(corners.points[GondolaCorners::BOTTOM_RIGHT] + weight_offset);
+}
+
+void Balloon::add_colliders(CollisionWorld& world)
+{
+    world.add(&gondola, &gondola);
+    world.add(&envelope, &envelope);
+    world.add(&weight_1, &weight_1);
+    world.add(&weight_2, &weight_2);
 }
 
 void Balloon::draw(const DrawState* state)
@@ -53,12 +68,10 @@ void Balloon::draw(const DrawState* state)
     }
 }
 
-void Balloon::pre_step(const StepState* state)
+void Balloon::pre_step(const WorldState* state)
 {
     // Update rope broken parameters
-    const WorldState* world_state = dynamic_cast<const WorldState*>(state);
-
-    if (world_state->input_manager->get_key_rising_edge(ALLEGRO_KEY_1))
+    if (state->input->get_key_rising_edge(ALLEGRO_KEY_1))
     {
         if (rope_3.get_broken())
         {
@@ -70,7 +83,7 @@ void Balloon::pre_step(const StepState* state)
         }
     }
 
-    if (world_state->input_manager->get_key_rising_edge(ALLEGRO_KEY_2))
+    if (state->input->get_key_rising_edge(ALLEGRO_KEY_2))
     {
         if (rope_4.get_broken())
         {
@@ -82,35 +95,100 @@ void Balloon::pre_step(const StepState* state)
         }
     }
 
+    // Run each object pre-state
+    for (auto& obj : objects)
+    {
+        obj->pre_step(state);
+    }
+}
+
+void Balloon::apply_forces(const WorldState* state)
+{
+    // Clear the forces and moments from any previous evaluation
+    bodies.reset_forces();
+
     // Setup/update the rope points
+    update_rope_points();
+
+    // Apply the forces for each object
+    for (auto& obj : objects)
+    {
+        obj->apply_forces(state);
+    }
+
+    // Limit the gondola moment once all forces are included
+    gondola.limit_moment();
+}
+
+void Balloon::update_rope_points()
+{
+    const GondolaCorners corners = gondola.get_corners();
+
     rope_1.set_point_a(envelope.anchor_point_left());
-    rope_1.set_point_b(gondola.get_top_left());
+    rope_1.set_point_b(corners.points[GondolaCorners::TOP_LEFT]);
 
     rope_2.set_point_a(envelope.anchor_point_right());
-    rope_2.set_point_b(gondola.get_top_right());
+    rope_2.set_point_b(corners.points[GondolaCorners::TOP_RIGHT]);
 
-    rope_3.set_point_a(gondola.get_bottom_left());
+    rope_3.set_point_a(corners.points[GondolaCorners::BOTTOM_LEFT]);
     rope_3.set_point_b(weight_1.get_position());
 
-    rope_4.set_point_a(gondola.get_bottom_right());
+    rope_4.set_point_a(corners.points[GondolaCorners::BOTTOM_RIGHT]);
     rope_4.set_point_b(weight_2.get_position());
+}
 
-    // Run each object pre-state
-    for (auto& obj : objects)
-    {
-        obj->pre_step(state);
-    }
+void Balloon::collect_rope_constraints()
+{
+    update_rope_points();
+
+    rope_solver.clear();
+
+    rope_1.add_constraint(rope_solver);
+    rope_2.add_constraint(rope_solver);
+    rope_3.add_constraint(rope_solver);
+    rope_4.add_constraint(rope_solver);
 }
 
-void Balloon::step(const StepState* state)
+void Balloon::step(const WorldState* state)
 {
     for (auto& obj : objects)
     {
         obj->step(state);
     }
+
+    // Create the integrator requested by the world state if needed
+    if (integrator == nullptr || integrator->get_type() != state->integrator)
+    {
+        integrator = Integrator::create(state->integrator);
+    }
+
+    // Integrate all balloon bodies at once, re-evaluating forces as required by the integrator
+    integrator->integrate(
+        bodies,
+        *state,
+        [this, state](const double stage_time)
+        {
+            envelope.set_stage_time(stage_time);
+            apply_forces(state);
+        });
+
+    // Pull any constraint ropes back within their lengths, repeating the position solve for the changed anchor points
+    if (state->rope_mode == RopeMode::CONSTRAINT)
+    {
+        const size_t POSITION_ITERATIONS = 2;
+
+        for (size_t i = 0; i < POSITION_ITERATIONS; ++i)
+        {
+            collect_rope_constraints();
+            rope_solver.solve_positions();
+        }
+
+        collect_rope_constraints();
+        rope_solver.solve_velocities();
+    }
 }
 
-void Balloon::post_step(const StepState* state)
+void Balloon::post_step(const WorldState* state)
 {
     for (auto& obj : objects)
     {
@@ -118,6 +196,50 @@ void Balloon::post_step(const StepState* state)
     }
 }
 
+void Balloon::write_snapshot(BalloonSnapshot& snapshot)
+{
+#ifndef GIO_HEADLESS
+    // Advance the rope chains, which are only visual and so are only stepped when a frame is published
+    rope_1.update_particles();
+    rope_2.update_particles();
+    rope_3.update_particles();
+    rope_4.update_particles();
+#endif
+
+    // Copy the body state, which reuses the snapshot storage once it has been sized
+    snapshot.bodies = bodies;
+
+    snapshot.temperature_ratio = envelope.get_temp_ratio();
+    snapshot.burner_on = envelope.get_burner_on();
+    snapshot.valve_open = envelope.get_valve_open();
+
+    rope_1.write_snapshot(snapshot.ropes[0]);
+    rope_2.write_snapshot(snapshot.ropes[1]);
+    rope_3.write_snapshot(snapshot.ropes[2]);
+    rope_4.write_snapshot(snapshot.ropes[3]);
+}
+
+void Balloon::read_snapshot(const BalloonSnapshot& snapshot)
+{
+    // Only take the body state if the snapshot was written by a matching balloon, keeping the
+    // current poses to draw from while interpolating towards the new state
+    if (snapshot.bodies.size() == bodies.size())
+    {
+        bodies.store_previous_poses();
+        bodies.copy_state(snapshot.bodies);
+    }
+
+    envelope.set_display_state(
+        snapshot.temperature_ratio,
+        snapshot.burner_on,
+        snapshot.valve_open);
+
+    rope_1.read_snapshot(snapshot.ropes[0]);
+    rope_2.read_snapshot(snapshot.ropes[1]);
+    rope_3.read_snapshot(snapshot.ropes[2]);
+    rope_4.read_snapshot(snapshot.ropes[3]);
+}
+
 const Envelope& Balloon::get_envelope() const
 {
     return envelope;
@@ -127,3 +249,22 @@ const Gondola& Balloon::get_gondola() const
 {
     return gondola;
 }
+
+Envelope& Balloon::get_envelope()
+{
+    return envelope;
+}
+
+Gondola& Balloon::get_gondola()
+{
+    return gondola;
+}
+
+bool Balloon::contains_body(const PhysicsBody* body) const
+{
+    return
+        body == &gondola ||
+        body == &envelope ||
+        body == &weight_1 ||
+        body == &weight_2;
+}
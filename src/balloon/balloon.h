@@ -1,48 +1,116 @@
 #ifndef BALLOON_H
 #define BALLOON_H
 
+#include <gamelib/collision_world.h>
+#include <gamelib/distance_constraint.h>
 #include <gamelib/game_object.h>
+#include <gamelib/integrator.h>
+#include <gamelib/rigid_body_set.h>
 
 #include "gondola.h"
 #include "envelope.h"
 #include "rope.h"
+#include "rope_chain.h"
 #include "weight.h"
 
+#include <world_state.h>
+
+#include <memory>
 #include <vector>
 
-class Balloon : public GameObject
+/**
+ * @brief Provides the state needed to draw a balloon, copied out of the simulation so that it can be
+ * drawn on a different thread than the one stepping the simulation
+ */
+struct BalloonSnapshot
+{
+    RigidBodySet bodies;
+
+    double temperature_ratio = 0.0;
+    bool burner_on = false;
+    bool valve_open = false;
+
+    RopeSnapshot ropes[4];
+};
+
+class Balloon : public GameObject<WorldState>
 {
 public:
     Balloon();
 
+    // The bodies, the object list and the rope anchors point into the balloon itself, so it cannot move
+    Balloon(const Balloon&) = delete;
+    Balloon(Balloon&&) = delete;
+    Balloon& operator=(const Balloon&) = delete;
+    Balloon& operator=(Balloon&&) = delete;
+
     void set_position(const double x, const double y);
 
+    /**
+     * @brief registers the gondola, envelope and weights with a collision world, which must then be
+     * resolved after each step
+     * @param world the collision world to add the bodies to
+     */
+    void add_colliders(CollisionWorld& world);
+
     virtual void draw(const DrawState* state) override;
 
-    virtual void pre_step(const StepState* state) override;
+    virtual void pre_step(const WorldState* state) override;
 
-    virtual void step(const StepState* state) override;
+    virtual void apply_forces(const WorldState* state) override;
 
-    virtual void post_step(const StepState* state) override;
+    virtual void step(const WorldState* state) override;
+
+    virtual void post_step(const WorldState* state) override;
 
     const Envelope& get_envelope() const;
 
     const Gondola& get_gondola() const;
 
+    Envelope& get_envelope();
+
+    Gondola& get_gondola();
+
+    /**
+     * @brief determines if a body is one of the balloon bodies
+     * @param body the body to check
+     * @return true if the body belongs to the balloon
+     */
+    bool contains_body(const PhysicsBody* body) const;
+
+    /**
+     * @brief copies the state needed to draw the balloon, first bringing the rope chains up to date
+     * @param snapshot the snapshot to write
+     */
+    void write_snapshot(BalloonSnapshot& snapshot);
+
+    void read_snapshot(const BalloonSnapshot& snapshot);
+
+protected:
+    void update_rope_points();
+
+    void collect_rope_constraints();
+
 protected:
+    RigidBodySet bodies;
+
     Gondola gondola;
     Envelope envelope;
 
-    Rope rope_1;
-    Rope rope_2;
+    RopeChain rope_1;
+    RopeChain rope_2;
 
     Weight weight_1;
     Weight weight_2;
 
-    Rope rope_3;
-    Rope rope_4;
+    RopeChain rope_3;
+    RopeChain rope_4;
+
+    std::vector<GameObject<WorldState>*> objects;
+
+    std::unique_ptr<Integrator> integrator;
 
-    std::vector<GameObject*> objects;
+    DistanceConstraintSolver rope_solver;
 };
 
 #endif // BALLOON_H
@@ -1,10 +1,16 @@
 #include "envelope.h"
 
+#include <algorithm>
+
+#ifndef GIO_HEADLESS
 #include <allegro5/allegro.h>
 #include <allegro5/allegro_primitives.h>
+#endif
 
-Envelope::Envelope() :
-    AeroObject(0.5, 100.0),
+Envelope::Envelope(RigidBodySet& body_set) :
+    AeroObject(body_set, 0.5, 100.0),
+    temperature_rate(0.0),
+    lateral_force(0.0),
     burner_on(false),
     valve_open(false)
 {
@@ -12,11 +18,12 @@ Envelope::Envelope() :
     radius = 60.0;
 
     // Define phsyics parameters
-    mass = 10.0;
-    inertia = 5.0;
+    set_mass(10.0);
+    set_inertia(5.0);
 
     // Setup the initial temperature
     current_temperature_ratio = 0.5;
+    step_temperature_ratio = current_temperature_ratio;
 }
 
 double Envelope::get_radius() const
@@ -24,20 +31,40 @@ double Envelope::get_radius() const
     return interpolate_value(60.0, 100.0);
 }
 
+BoundingBox Envelope::get_bounding_box() const
+{
+    return BoundingBox::around_circle(get_position(), get_radius());
+}
+
+CollisionShape Envelope::get_collision_shape() const
+{
+    return CollisionShape::circle(get_position(), get_radius());
+}
+
 Vector2 Envelope::anchor_point_left() const
 {
-    return position - Vector2(get_radius(), 0.0).rotate_deg(-30).rotate_rad(rotation);
+    return get_position() - Vector2(get_radius(), 0.0).rotate_deg(-30).rotate_rad(get_rotation());
 }
 
 Vector2 Envelope::anchor_point_right() const
 {
-    return position + Vector2(get_radius(), 0.0).rotate_deg(30).rotate_rad(rotation);
+    return get_position() + Vector2(get_radius(), 0.0).rotate_deg(30).rotate_rad(get_rotation());
 }
 
+#ifdef GIO_HEADLESS
+void Envelope::draw(const DrawState*)
+{
+    // Nothing to draw without a display
+}
+#else
 void Envelope::draw(const DrawState* state)
 {
+    // Define the interpolated pose to draw
+    const Vector2 draw_pos = get_draw_position(state->interpolation_alpha);
+    const double draw_rot = get_draw_rotation(state->interpolation_alpha);
+
     // Define the screen position
-    const Vector2 screen_pos = position - state->draw_offset;
+    const Vector2 screen_pos = draw_pos - state->draw_offset;
 
     // Draw the envelope
     al_draw_filled_circle(
@@ -50,8 +77,8 @@ void Envelope::draw(const DrawState* state)
             static_cast<unsigned char>(interpolate_value(100.0, 0.0))));
 
     // Define the anchor points
-    const Vector2 a_left = anchor_point_left() - state->draw_offset;
-    const Vector2 a_right = anchor_point_right() - state->draw_offset;
+    const Vector2 a_left = draw_pos - Vector2(get_radius(), 0.0).rotate_deg(-30).rotate_rad(draw_rot) - state->draw_offset;
+    const Vector2 a_right = draw_pos + Vector2(get_radius(), 0.0).rotate_deg(30).rotate_rad(draw_rot) - state->draw_offset;
 
     // Draw the anchor points
     al_draw_filled_circle(
@@ -65,37 +92,86 @@ void Envelope::draw(const DrawState* state)
         5.0f,
         al_map_rgb(0, 0, 0));
 }
+#endif
+
+void Envelope::set_display_state(
+    const double temperature_ratio,
+    const bool burner,
+    const bool valve)
+{
+    current_temperature_ratio = temperature_ratio;
+    step_temperature_ratio = temperature_ratio;
+    burner_on = burner;
+    valve_open = valve;
+}
 
 double Envelope::interpolate_value(const double min_val, const double max_val) const
 {
     return min_val * (1.0 - current_temperature_ratio) + max_val * current_temperature_ratio;
 }
 
-void Envelope::pre_step(const StepState* state)
+void Envelope::pre_step(const WorldState* state)
 {
     // Perform Pre-Step Items
     AeroObject::pre_step(state);
 
-    // Setup lift
-    double vert_force = interpolate_value(300.0, 1300.0);
-    if (state->input_manager->get_dir_up())
+    // Update the burner and valve from the inputs
+    burner_on = state->input->get_dir_up();
+    valve_open = state->input->get_dir_down();
+
+    // Determine the temperature rate of change over the step
+    step_temperature_ratio = current_temperature_ratio;
+    temperature_rate = -0.02 * current_temperature_ratio;
+    if (burner_on)
     {
-        current_temperature_ratio += 0.1 * state->time_step;
-        burner_on = true;
+        temperature_rate += 0.1;
     }
-    else
+    if (valve_open)
     {
-        burner_on = false;
+        temperature_rate -= 0.1;
     }
 
-    if (state->input_manager->get_dir_down())
+    // Setup lateral forces
+    const double lat_force_max = 200.0;
+    lateral_force = 0.0;
+    if (state->input->get_dir_right())
     {
-        current_temperature_ratio -= 0.1 * state->time_step;
-        valve_open = true;
+        lateral_force += lat_force_max;
     }
-    else
+    if (state->input->get_dir_left())
     {
-        valve_open = false;
+        lateral_force -= lat_force_max;
+    }
+}
+
+void Envelope::apply_forces(const WorldState* state)
+{
+    // Apply the aerodynamics forces
+    AeroObject::apply_forces(state);
+
+    // Setup lift
+    const double vert_force = interpolate_value(300.0, 1300.0);
+
+    // Apply forces
+    add_force_absolute(Vector2(lateral_force, -vert_force));
+}
+
+void Envelope::post_step(const WorldState* state)
+{
+    // Perform Post-Step Items
+    AeroObject::post_step(state);
+
+    // Update the temperature once the physics step is complete
+    current_temperature_ratio = step_temperature_ratio;
+
+    if (burner_on)
+    {
+        current_temperature_ratio += 0.1 * state->time_step;
+    }
+
+    if (valve_open)
+    {
+        current_temperature_ratio -= 0.1 * state->time_step;
     }
 
     // Decay the current temperature
@@ -103,21 +179,19 @@ void Envelope::pre_step(const StepState* state)
 
     // Limit the current temperature value
     current_temperature_ratio = std::min(std::max(0.0, current_temperature_ratio), 1.0);
+}
 
-    // Setup lateral forces
-    const double lat_force_max = 200.0;
-    double lat_force = 0.0;
-    if (state->input_manager->get_dir_right())
+void Envelope::set_stage_time(const double stage_time)
+{
+    // Interpolate the temperature within the step so that multi-stage integrators see the lift change
+    if (stage_time > 0.0)
     {
-        lat_force += lat_force_max;
+        current_temperature_ratio = std::min(std::max(0.0, step_temperature_ratio + temperature_rate * stage_time), 1.0);
     }
-    if (state->input_manager->get_dir_left())
+    else
     {
-        lat_force -= lat_force_max;
+        current_temperature_ratio = step_temperature_ratio;
     }
-
-    // Apply forces
-    add_force_absolute(Vector2(lat_force, -vert_force));
 }
 
 bool Envelope::get_valve_open() const
@@ -1,15 +1,17 @@
 #ifndef ENVELOPE_H
 #define ENVELOPE_H
 
-#include <allegro5/bitmap.h>
-
 #include <gamelib/aero_object.h>
+#include <gamelib/bounding_box.h>
+#include <gamelib/collision.h>
 #include <gamelib/vector2.h>
 
-class Envelope : public AeroObject
+#include <world_state.h>
+
+class Envelope : public AeroObject<WorldState>, public Collider
 {
 public:
-    Envelope();
+    explicit Envelope(RigidBodySet& body_set);
 
     Vector2 anchor_point_left() const;
 
@@ -17,7 +19,17 @@ public:
 
     double get_radius() const;
 
-    virtual void pre_step(const StepState* state) override;
+    BoundingBox get_bounding_box() const;
+
+    virtual CollisionShape get_collision_shape() const override;
+
+    virtual void pre_step(const WorldState* state) override;
+
+    virtual void apply_forces(const WorldState* state) override;
+
+    virtual void post_step(const WorldState* state) override;
+
+    void set_stage_time(const double stage_time);
 
     virtual void draw(const DrawState* state) override;
 
@@ -29,6 +41,11 @@ public:
 
     double get_temp_ratio() const;
 
+    void set_display_state(
+        const double temperature_ratio,
+        const bool burner,
+        const bool valve);
+
     ~Envelope();
 
 protected:
@@ -36,6 +53,11 @@ protected:
 
     double current_temperature_ratio;
 
+    double step_temperature_ratio;
+    double temperature_rate;
+
+    double lateral_force;
+
     bool burner_on;
     bool valve_open;
 };
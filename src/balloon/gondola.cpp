@@ -1,18 +1,19 @@
 #include "gondola.h"
 
 #include <cmath>
-#include <stdexcept>
 
+#ifndef GIO_HEADLESS
 #include <allegro5/allegro.h>
 #include <allegro5/allegro_primitives.h>
+#endif
 
 #include <world_state.h>
 
-Gondola::Gondola() :
-    AeroObject(0.1, 50.0)
+Gondola::Gondola(RigidBodySet& body_set) :
+    AeroObject(body_set, 0.1, 50.0)
 {
-    mass = 50.0;
-    inertia = 50.0;
+    set_mass(50.0);
+    set_inertia(50.0);
     width = 40.0;
     height = 30.0;
     bitmap = nullptr;
@@ -20,42 +21,65 @@ Gondola::Gondola() :
 
 Vector2 Gondola::get_top_left() const
 {
-    return position + Vector2(
+    return get_position() + Vector2(
         -width / 2.0,
-        -height / 2.0).rotate_rad(rotation);
+        -height / 2.0).rotate_rad(get_rotation());
 }
 
 Vector2 Gondola::get_top_right() const
 {
-    return position + Vector2(
+    return get_position() + Vector2(
         width / 2.0,
-        -height / 2.0).rotate_rad(rotation);
+        -height / 2.0).rotate_rad(get_rotation());
 }
 
 Vector2 Gondola::get_bottom_left() const
 {
-    return position + Vector2(
+    return get_position() + Vector2(
         -width / 2.0,
-        height / 2.0).rotate_rad(rotation);
+        height / 2.0).rotate_rad(get_rotation());
 }
 
 Vector2 Gondola::get_bottom_right() const
 {
-    return position + Vector2(
+    return get_position() + Vector2(
         width / 2.0,
-        height / 2.0).rotate_rad(rotation);
+        height / 2.0).rotate_rad(get_rotation());
 }
 
-std::vector<Vector2> Gondola::get_points() const
+GondolaCorners Gondola::get_corners() const
 {
-    return {
-        get_top_left(),
-        get_bottom_left(),
-        get_bottom_right(),
-        get_top_right()
-    };
+    const Vector2 position = get_position();
+    const SinCos angle(get_rotation());
+
+    const double half_width = width / 2.0;
+    const double half_height = height / 2.0;
+
+    GondolaCorners corners;
+    corners.points[GondolaCorners::TOP_LEFT] = position + Vector2(-half_width, -half_height).rotate_rad(angle);
+    corners.points[GondolaCorners::BOTTOM_LEFT] = position + Vector2(-half_width, half_height).rotate_rad(angle);
+    corners.points[GondolaCorners::BOTTOM_RIGHT] = position + Vector2(half_width, half_height).rotate_rad(angle);
+    corners.points[GondolaCorners::TOP_RIGHT] = position + Vector2(half_width, -half_height).rotate_rad(angle);
+    return corners;
 }
 
+BoundingBox Gondola::get_bounding_box() const
+{
+    return get_collision_shape().get_bounding_box();
+}
+
+CollisionShape Gondola::get_collision_shape() const
+{
+    const GondolaCorners corners = get_corners();
+    return CollisionShape::polygon(gio::Span<const Vector2>(corners.points));
+}
+
+#ifdef GIO_HEADLESS
+void Gondola::draw(const DrawState*)
+{
+    // Nothing to draw without a display
+}
+#else
 void Gondola::draw(const DrawState* state)
 {
     if (bitmap == nullptr)
@@ -86,82 +110,75 @@ void Gondola::draw(const DrawState* state)
         al_set_target_bitmap(prev_bitmap);
     }
 
-    // Draw the resulting bitmap on screen
+    // Draw the resulting bitmap on screen at the interpolated pose
+    const Vector2 draw_pos = get_draw_position(state->interpolation_alpha);
+
     al_draw_rotated_bitmap(
         bitmap,
         static_cast<float>(width) / 2.0f,
         static_cast<float>(height) / 2.0f,
-        static_cast<float>(position.x - state->draw_offset.x),
-        static_cast<float>(position.y - state->draw_offset.y),
-        static_cast<float>(rotation),
+        static_cast<float>(draw_pos.x - state->draw_offset.x),
+        static_cast<float>(draw_pos.y - state->draw_offset.y),
+        static_cast<float>(get_draw_rotation(state->interpolation_alpha)),
         0);
 }
+#endif
 
-void Gondola::pre_step(const StepState* state)
+void Gondola::apply_forces(const WorldState* state)
 {
-    // Run the super-pre-step
-    AeroObject::pre_step(state);
+    // Run the super force application
+    AeroObject::apply_forces(state);
 
-    // Check the correct step state
-    const WorldState* world_state = dynamic_cast<const WorldState*>(state);
-    if (world_state == nullptr)
-    {
-        throw std::runtime_error("world step must get a physics object for correct computations");
-    }
+    // Find the contacts between the gondola and the terrain, if any
+    ContactManifold manifold;
+    gio::collide_heightfield(get_collision_shape(), *state->terrain, manifold);
 
-    // Define the points to check parameters for
-    const std::vector<Vector2> points = get_points();
+    // Extract the current body state
+    const Vector2 position = get_position();
+    const Vector2 velocity = get_velocity();
+    const double rotational_vel = get_rotational_velocity();
 
-    // Check each corner for hitting the ground
-    for (auto it = points.begin(); it != points.end(); ++it)
+    // Push back against the terrain at each contact point
+    for (size_t i = 0; i < manifold.count; ++i)
     {
-        // Determine the elevation point for the current point
-        const double elev = world_state->terrain->elevation_at_x(it->x);
+        const ContactPoint& contact = manifold.points[i];
 
         // Determine the offset to the center and the resulting point velocity
-        const Vector2 point_offset = *it - position;
+        const Vector2 point_offset = contact.point - position;
         const Vector2 point_vel = velocity + Vector2(
             -point_offset.y,
             point_offset.x) * rotational_vel;
 
         // Obtain the surface normal
-        const Vector2 surf_norm = Vector2(0.0, -1.0);
+        const Vector2 surf_norm = contact.normal;
 
         // Setup the normal and frictional forces
         Vector2 normal_force;
         Vector2 frictional_force;
 
-        double downward_force = 0.0;
-
-        // Calculate the terrain forces if necessary
-        if (it->y > elev)
-        {
-            // Calculate the normal force spring and damping forces
-            Vector2 spring_force = it->distance_to(Vector2(it->x, elev)) * world_state->terrain->get_spring_constant() * surf_norm;
+        // Calculate the normal force spring and damping forces
+        const Vector2 spring_force = contact.penetration * state->terrain->get_spring_constant() * surf_norm;
 
-            const double upward_damping_force = -surf_norm.dot(point_vel);
-            //const double downward_damping_force = -0.1 * mass * world_state->gravity.magnitude();
-            const double downward_damping_force = 0.0;
+        const double upward_damping_force = -surf_norm.dot(point_vel);
+        const double downward_damping_force = 0.0;
 
-            Vector2 damping_force = std::max(downward_damping_force, upward_damping_force) * world_state->terrain->get_damping_coefficient() * surf_norm;
-            //damping_force = damping_force * std::min((damping_force.magnitude_squared() / spring_force.magnitude_squared()), 0.1);
+        const Vector2 damping_force = std::max(downward_damping_force, upward_damping_force) * state->terrain->get_damping_coefficient() * surf_norm;
 
-            normal_force += spring_force;
-            normal_force += damping_force;
+        normal_force += spring_force;
+        normal_force += damping_force;
 
-            // Determine the along-terrain force and magnitude velocity-wise
-            Vector2 along_terrain = surf_norm.rotate_deg(90.0);
-            along_terrain *= -velocity.dot(along_terrain);
+        // Determine the along-terrain force and magnitude velocity-wise
+        Vector2 along_terrain = surf_norm.rotate_deg(90.0);
+        along_terrain *= -velocity.dot(along_terrain);
 
-            // Determine static vs. kinematic frictional coefficient
-            const double FRICTION_COEFF = (std::abs(point_vel.dot(along_terrain)) > 1.0) ? 0.15 : 0.25;
+        // Determine static vs. kinematic frictional coefficient
+        const double FRICTION_COEFF = (std::abs(point_vel.dot(along_terrain)) > 1.0) ? 0.15 : 0.25;
 
-            // Determine the downward force on the object
-            downward_force = std::max(0.0, normal_force.dot(surf_norm));
+        // Determine the downward force on the object
+        const double downward_force = std::max(0.0, normal_force.dot(surf_norm));
 
-            // Set the frictional force
-            frictional_force = FRICTION_COEFF * downward_force * along_terrain;
-        }
+        // Set the frictional force
+        frictional_force = FRICTION_COEFF * downward_force * along_terrain;
 
         // Apply the forces
         add_force_absolute(normal_force, point_offset);
@@ -169,21 +186,20 @@ void Gondola::pre_step(const StepState* state)
     }
 }
 
-void Gondola::step(const StepState* state)
+void Gondola::limit_moment()
 {
     // Limit the moments allowed
     const double MOMENT_LIM = 2000.0;
-    moments = std::max(-MOMENT_LIM, std::min(MOMENT_LIM, moments));
-
-    // Call the super-state
-    AeroObject::step(state);
+    set_moment(std::max(-MOMENT_LIM, std::min(MOMENT_LIM, get_moment())));
 }
 
 Gondola::~Gondola()
 {
+#ifndef GIO_HEADLESS
     if (bitmap != nullptr)
     {
         al_destroy_bitmap(bitmap);
         bitmap = nullptr;
     }
+#endif
 }
@@ -2,22 +2,41 @@
 #define GONDOLA_H
 
 #include <gamelib/aero_object.h>
+#include <gamelib/bounding_box.h>
+#include <gamelib/collision.h>
 #include <gamelib/vector2.h>
 
-#include <vector>
+#include <world_state.h>
 
-#include <allegro5/bitmap.h>
+#include <cstddef>
+
+struct ALLEGRO_BITMAP;
+
+/**
+ * @brief the four corners of the gondola in global coordinates, in order around the box
+ */
+struct GondolaCorners
+{
+    static const size_t TOP_LEFT = 0;
+    static const size_t BOTTOM_LEFT = 1;
+    static const size_t BOTTOM_RIGHT = 2;
+    static const size_t TOP_RIGHT = 3;
+    static const size_t COUNT = 4;
+
+    Vector2 points[COUNT];
+};
 
 /**
  * @brief Provides information for the balloon gondola
  */
-class Gondola : public AeroObject
+class Gondola : public AeroObject<WorldState>, public Collider
 {
 public:
     /**
      * @brief Constructs the core balloon gondola
+     * @param body_set the rigid body set to store the gondola body in
      */
-    Gondola();
+    explicit Gondola(RigidBodySet& body_set);
 
     /**
      * @brief Provides the corresponding Gondola point
@@ -43,6 +62,25 @@ public:
      */
     Vector2 get_bottom_right() const;
 
+    /**
+     * @brief Provides all four Gondola points at once, sharing a single sine and cosine of the rotation,
+     * which should be preferred over the single point functions when more than one point is needed
+     * @return the Gondola points in global coordinates
+     */
+    GondolaCorners get_corners() const;
+
+    /**
+     * @brief Provides the axis-aligned box around the Gondola corners
+     * @return the bounding box in global coordinates
+     */
+    BoundingBox get_bounding_box() const;
+
+    /**
+     * @brief Provides the box shape of the Gondola for collision tests
+     * @return the collision shape in global coordinates
+     */
+    virtual CollisionShape get_collision_shape() const override;
+
     /**
      * @brief Draws the balloon gondola onto the current display
      * @param state the draw state for the current object
@@ -53,20 +91,16 @@ public:
      * @brief Adds the correct forces to the Gondola
      * @param state the step state to utilize
      */
-    void pre_step(const StepState* state) override;
+    void apply_forces(const WorldState* state) override;
 
     /**
-     * @brief Provides an update on the default step parameters to run right before performing the physics step
-     * @param state the step state to utilize
+     * @brief Limits the accumulated moment, to be called once all forces for the current body state have been applied
     */
-    void step(const StepState* state) override;
+    void limit_moment();
 
     /* Destructor */
     ~Gondola();
 
-protected:
-    std::vector<Vector2> get_points() const;
-
 protected:
     double width;
     double height;
@@ -1,26 +1,30 @@
 #include "rope.h"
 
+#include <algorithm>
+#include <cmath>
+
+#ifndef GIO_HEADLESS
 #include <allegro5/allegro.h>
 #include <allegro5/allegro_primitives.h>
-
-#include <cmath>
+#endif
 
 Rope::Rope(const double spring_constant) :
     spring_constant(spring_constant),
     init_length(-1.0),
-    broken(false)
+    broken(false),
+    has_previous_points(false)
 {
     obj_a = nullptr;
     obj_b = nullptr;
 }
 
-void Rope::set_object_a(PhysicsObject* obj)
+void Rope::set_object_a(PhysicsBody* obj)
 {
     obj_a = obj;
     init_length = -1.0;
 }
 
-void Rope::set_object_b(PhysicsObject* obj)
+void Rope::set_object_b(PhysicsBody* obj)
 {
     obj_b = obj;
     init_length = -1.0;
@@ -51,6 +55,11 @@ double Rope::get_init_length() const
     return init_length;
 }
 
+void Rope::set_init_length(const double length)
+{
+    init_length = length;
+}
+
 bool Rope::try_reattach_rope()
 {
     if (point_a.distance_to(point_b) < init_length)
@@ -60,13 +69,25 @@ bool Rope::try_reattach_rope()
     return !broken;
 }
 
+#ifdef GIO_HEADLESS
+void Rope::draw(const DrawState*)
+{
+    // Nothing to draw without a display
+}
+#else
 void Rope::draw(const DrawState* state)
 {
     // Draw the line
     if (!broken)
     {
-        const Vector2 screen_a = point_a - state->draw_offset;
-        const Vector2 screen_b = point_b - state->draw_offset;
+        // Interpolate from the previous snapshot points if any have been read
+        const double alpha = has_previous_points ? state->interpolation_alpha : 1.0;
+
+        const Vector2 draw_a = previous_point_a + (point_a - previous_point_a) * alpha;
+        const Vector2 draw_b = previous_point_b + (point_b - previous_point_b) * alpha;
+
+        const Vector2 screen_a = draw_a - state->draw_offset;
+        const Vector2 screen_b = draw_b - state->draw_offset;
 
         al_draw_line(
             static_cast<float>(screen_a.x),
@@ -77,11 +98,12 @@ void Rope::draw(const DrawState* state)
             2.0f);
     }
 }
+#endif
 
-void Rope::pre_step(const StepState* state)
+void Rope::apply_forces(const WorldState* state)
 {
     // Run the super state
-    GameObject::pre_step(state);
+    GameObject::apply_forces(state);
 
     // Skip computation and force adding if broken
     if (broken)
@@ -95,6 +117,12 @@ void Rope::pre_step(const StepState* state)
         init_length = (point_a - point_b).magnitude();
     }
 
+    // Constraint ropes apply no forces, and are instead solved after integration
+    if (state->rope_mode == RopeMode::CONSTRAINT)
+    {
+        return;
+    }
+
     // Determine the spring force
     const double spring_force = spring_constant * std::max(((point_a - point_b).magnitude() - init_length), 0.0);
     
@@ -107,3 +135,42 @@ void Rope::pre_step(const StepState* state)
     obj_a->add_force_absolute(force_dir * spring_force, offset_a);
     obj_b->add_force_absolute(force_dir * -spring_force, offset_b);
 }
+
+void Rope::write_snapshot(RopeSnapshot& snapshot) const
+{
+    snapshot.point_a = point_a;
+    snapshot.point_b = point_b;
+    snapshot.init_length = init_length;
+    snapshot.broken = broken;
+}
+
+void Rope::read_snapshot(const RopeSnapshot& snapshot)
+{
+    // Keep the points from the last snapshot to interpolate from, or start from the new points
+    previous_point_a = has_previous_points ? point_a : snapshot.point_a;
+    previous_point_b = has_previous_points ? point_b : snapshot.point_b;
+    has_previous_points = true;
+
+    point_a = snapshot.point_a;
+    point_b = snapshot.point_b;
+    init_length = snapshot.init_length;
+    broken = snapshot.broken;
+}
+
+void Rope::add_constraint(DistanceConstraintSolver& solver) const
+{
+    // Skip if broken or not yet initialized
+    if (broken || init_length < 0.0)
+    {
+        return;
+    }
+
+    DistanceConstraint constraint;
+    constraint.body_a = obj_a;
+    constraint.body_b = obj_b;
+    constraint.point_a = point_a;
+    constraint.point_b = point_b;
+    constraint.length = init_length;
+
+    solver.add(constraint);
+}
@@ -1,17 +1,38 @@
 #ifndef ROPE_H
 #define ROPE_H
 
+#include <gamelib/distance_constraint.h>
 #include <gamelib/vector2.h>
 #include <gamelib/physics_object.h>
 
-class Rope : public GameObject
+#include <world_state.h>
+
+#include <vector>
+
+/**
+ * @brief Provides the state needed to draw a rope, copied out of the simulation
+ */
+struct RopeSnapshot
+{
+    Vector2 point_a;
+    Vector2 point_b;
+
+    double init_length = -1.0;
+    bool broken = false;
+
+    bool particles_valid = false;
+    std::vector<double> particle_x;
+    std::vector<double> particle_y;
+};
+
+class Rope : public GameObject<WorldState>
 {
 public:
     Rope(const double spring_constant);
 
-    void set_object_a(PhysicsObject* obj);
+    void set_object_a(PhysicsBody* obj);
 
-    void set_object_b(PhysicsObject* obj);
+    void set_object_b(PhysicsBody* obj);
 
     void set_point_a(const Vector2& p);
 
@@ -25,9 +46,22 @@ public:
 
     double get_init_length() const;
 
+    /**
+     * @brief sets the length the rope is held within, instead of the distance between the points
+     * when forces are first applied. Must be called after the objects are set
+     * @param length the rope length
+     */
+    void set_init_length(const double length);
+
     virtual void draw(const DrawState* state) override;
 
-    virtual void pre_step(const StepState* state) override;
+    virtual void apply_forces(const WorldState* state) override;
+
+    void add_constraint(DistanceConstraintSolver& solver) const;
+
+    virtual void write_snapshot(RopeSnapshot& snapshot) const;
+
+    virtual void read_snapshot(const RopeSnapshot& snapshot);
 
 protected:
     double spring_constant;
@@ -35,11 +69,15 @@ protected:
 
     bool broken;
 
-    PhysicsObject* obj_a;
-    PhysicsObject* obj_b;
+    PhysicsBody* obj_a;
+    PhysicsBody* obj_b;
 
     Vector2 point_a;
     Vector2 point_b;
+
+    bool has_previous_points;
+    Vector2 previous_point_a;
+    Vector2 previous_point_b;
 };
 
 #endif // ROPE_H
@@ -0,0 +1,314 @@
+#include "rope_chain.h"
+
+#include <algorithm>
+#include <cmath>
+
+#ifndef GIO_HEADLESS
+#include <allegro5/allegro.h>
+#include <allegro5/allegro_primitives.h>
+#endif
+
+namespace
+{
+    /**
+     * @brief the fraction of each particle's velocity lost per second to air drag
+     */
+    const double PARTICLE_DAMPING = 0.5;
+
+    /**
+     * @brief the fixed time step used to advance the particles, which only need to look right and so are
+     * stepped far less often than the rigid bodies
+     */
+    const double CHAIN_TIME_STEP = 1.0 / 240.0;
+
+    /**
+     * @brief the most chain steps run by a single update, dropping any older time so that a chain that
+     * has not been drawn for a while does not have to catch up
+     */
+    const size_t MAX_CHAIN_STEPS_PER_UPDATE = 16;
+}
+
+RopeChain::RopeChain(
+    const double spring_constant,
+    const size_t segment_count) :
+    Rope(spring_constant),
+    segment_count(std::max<size_t>(1, segment_count)),
+    constraint_iterations(4),
+    particles_valid(false),
+    time_accumulator(0.0),
+    has_draw_previous(false)
+{
+    // Allocate the particle arrays once, including both anchor particles
+    const size_t particle_count = get_particle_count();
+
+    position_x.resize(particle_count, 0.0);
+    position_y.resize(particle_count, 0.0);
+    previous_x.resize(particle_count, 0.0);
+    previous_y.resize(particle_count, 0.0);
+    draw_previous_x.resize(particle_count, 0.0);
+    draw_previous_y.resize(particle_count, 0.0);
+
+    vertices.resize(particle_count * 2, 0.0f);
+}
+
+size_t RopeChain::get_segment_count() const
+{
+    return segment_count;
+}
+
+size_t RopeChain::get_particle_count() const
+{
+    return segment_count + 1;
+}
+
+Vector2 RopeChain::get_particle(const size_t i) const
+{
+    return Vector2(position_x[i], position_y[i]);
+}
+
+void RopeChain::set_constraint_iterations(const size_t iterations)
+{
+    constraint_iterations = iterations;
+}
+
+#ifdef GIO_HEADLESS
+void RopeChain::draw(const DrawState*)
+{
+    // Nothing to draw without a display
+}
+#else
+void RopeChain::draw(const DrawState* state)
+{
+    // Bring the chain up to date with the physics steps run since the last frame
+    update_particles();
+
+    // Draw nothing while broken, and a straight rope until the chain has been laid out
+    if (broken)
+    {
+        return;
+    }
+
+    if (!particles_valid)
+    {
+        Rope::draw(state);
+        return;
+    }
+
+    // Draw the whole chain as a single polyline, interpolated from the previous snapshot particles if any
+    const double alpha = has_draw_previous ? state->interpolation_alpha : 1.0;
+
+    for (size_t i = 0; i < get_particle_count(); ++i)
+    {
+        const double x = has_draw_previous ? draw_previous_x[i] + (position_x[i] - draw_previous_x[i]) * alpha : position_x[i];
+        const double y = has_draw_previous ? draw_previous_y[i] + (position_y[i] - draw_previous_y[i]) * alpha : position_y[i];
+
+        vertices[i * 2] = static_cast<float>(x - state->draw_offset.x);
+        vertices[i * 2 + 1] = static_cast<float>(y - state->draw_offset.y);
+    }
+
+    al_draw_polyline(
+        vertices.data(),
+        static_cast<int>(2 * sizeof(float)),
+        static_cast<int>(get_particle_count()),
+        ALLEGRO_LINE_JOIN_ROUND,
+        ALLEGRO_LINE_CAP_ROUND,
+        al_map_rgb(0, 0, 0),
+        2.0f,
+        1.0f);
+}
+#endif
+
+void RopeChain::post_step(const WorldState* state)
+{
+    // Run the super step
+    Rope::post_step(state);
+
+    // Skip the chain while broken or before the rope length is known, and lay it out again once it is needed
+    if (broken || init_length < 0.0)
+    {
+        particles_valid = false;
+        return;
+    }
+
+    // Only add up the time here, leaving the particles to be advanced when they are next needed
+    time_accumulator += state->time_step;
+    gravity = state->gravity;
+}
+
+void RopeChain::update_particles()
+{
+    if (broken || init_length < 0.0)
+    {
+        particles_valid = false;
+        return;
+    }
+
+    if (!particles_valid)
+    {
+        reset_particles();
+        return;
+    }
+
+    // Advance the chain by whole chain steps, carrying the remainder to the next update
+    const size_t step_count = static_cast<size_t>(time_accumulator / CHAIN_TIME_STEP);
+    if (step_count == 0)
+    {
+        return;
+    }
+
+    time_accumulator -= static_cast<double>(step_count) * CHAIN_TIME_STEP;
+
+    const size_t run_count = std::min(step_count, MAX_CHAIN_STEPS_PER_UPDATE);
+
+    for (size_t i = 1; i <= run_count; ++i)
+    {
+        // Move the end particles along with the anchors, as if the chain had been stepped with the bodies
+        const double fraction = static_cast<double>(i) / static_cast<double>(run_count);
+
+        integrate_particles(
+            particle_point_a + (point_a - particle_point_a) * fraction,
+            particle_point_b + (point_b - particle_point_b) * fraction,
+            CHAIN_TIME_STEP);
+        satisfy_constraints();
+    }
+
+    particle_point_a = point_a;
+    particle_point_b = point_b;
+}
+
+void RopeChain::write_snapshot(RopeSnapshot& snapshot) const
+{
+    Rope::write_snapshot(snapshot);
+
+    // Copy the particle positions, which reuses the snapshot storage once it has been sized
+    snapshot.particles_valid = particles_valid;
+    snapshot.particle_x = position_x;
+    snapshot.particle_y = position_y;
+}
+
+void RopeChain::read_snapshot(const RopeSnapshot& snapshot)
+{
+    Rope::read_snapshot(snapshot);
+
+    // Only take the particles if the chain layout matches
+    const bool had_particles = particles_valid;
+
+    particles_valid = snapshot.particles_valid && snapshot.particle_x.size() == position_x.size();
+    if (particles_valid)
+    {
+        // Keep the particles from the last snapshot to interpolate from, or start from the new particles
+        has_draw_previous = had_particles;
+        if (has_draw_previous)
+        {
+            draw_previous_x = position_x;
+            draw_previous_y = position_y;
+        }
+
+        position_x = snapshot.particle_x;
+        position_y = snapshot.particle_y;
+    }
+}
+
+void RopeChain::reset_particles()
+{
+    // Lay the particles out at rest along the straight line between the anchors
+    const size_t particle_count = get_particle_count();
+
+    for (size_t i = 0; i < particle_count; ++i)
+    {
+        const double fraction = static_cast<double>(i) / static_cast<double>(segment_count);
+        const Vector2 p = point_a + (point_b - point_a) * fraction;
+
+        position_x[i] = p.x;
+        position_y[i] = p.y;
+        previous_x[i] = p.x;
+        previous_y[i] = p.y;
+    }
+
+    particle_point_a = point_a;
+    particle_point_b = point_b;
+
+    particles_valid = true;
+    time_accumulator = 0.0;
+}
+
+void RopeChain::integrate_particles(
+    const Vector2& anchor_a,
+    const Vector2& anchor_b,
+    const double dt)
+{
+    const double retain = std::max(0.0, 1.0 - PARTICLE_DAMPING * dt);
+
+    const double accel_x = gravity.x * dt * dt;
+    const double accel_y = gravity.y * dt * dt;
+
+    double* const px = position_x.data();
+    double* const py = position_y.data();
+    double* const ox = previous_x.data();
+    double* const oy = previous_y.data();
+
+    // Advance the free particles with position Verlet integration
+    for (size_t i = 1; i < segment_count; ++i)
+    {
+        const double x = px[i];
+        const double y = py[i];
+
+        px[i] = x + (x - ox[i]) * retain + accel_x;
+        py[i] = y + (y - oy[i]) * retain + accel_y;
+
+        ox[i] = x;
+        oy[i] = y;
+    }
+
+    // Pin the end particles to the anchor points
+    px[0] = anchor_a.x;
+    py[0] = anchor_a.y;
+    px[segment_count] = anchor_b.x;
+    py[segment_count] = anchor_b.y;
+}
+
+void RopeChain::satisfy_constraints()
+{
+    const double segment_length = init_length / static_cast<double>(segment_count);
+    const size_t last = segment_count;
+
+    double* const px = position_x.data();
+    double* const py = position_y.data();
+
+    for (size_t iteration = 0; iteration < constraint_iterations; ++iteration)
+    {
+        // Pull each stretched segment back to its length, moving only the free particles and
+        // alternating the sweep direction so that neither anchor is favored
+        const bool forward = (iteration % 2) == 0;
+
+        for (size_t k = 0; k < segment_count; ++k)
+        {
+            const size_t i = forward ? k : segment_count - 1 - k;
+
+            const double dx = px[i + 1] - px[i];
+            const double dy = py[i + 1] - py[i];
+            const double dist = std::sqrt(dx * dx + dy * dy);
+
+            if (dist <= segment_length)
+            {
+                continue;
+            }
+
+            const double weight_a = (i == 0) ? 0.0 : 1.0;
+            const double weight_b = (i + 1 == last) ? 0.0 : 1.0;
+            const double weight_sum = weight_a + weight_b;
+
+            if (weight_sum <= 0.0)
+            {
+                continue;
+            }
+
+            const double correction = (dist - segment_length) / (dist * weight_sum);
+
+            px[i] += dx * correction * weight_a;
+            py[i] += dy * correction * weight_a;
+            px[i + 1] -= dx * correction * weight_b;
+            py[i + 1] -= dy * correction * weight_b;
+        }
+    }
+}
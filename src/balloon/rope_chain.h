@@ -0,0 +1,84 @@
+#ifndef ROPE_CHAIN_H
+#define ROPE_CHAIN_H
+
+#include "rope.h"
+
+#include <gamelib/vector2.h>
+
+#include <world_state.h>
+
+#include <cstddef>
+#include <vector>
+
+/**
+ * @brief A rope drawn as a chain of particles hanging between the two rope anchor points. The particles
+ * are integrated with Verlet integration and held to the segment length with distance constraints,
+ * so that slack ropes sag and swing. The chain is advanced on its own fixed time step and does not pull
+ * on the bodies, which the rope itself still does. Since the chain is only visual, the physics step only
+ * adds up the time passed, and the particles are advanced by update_particles where a frame is published
+ * or drawn. The particle state is stored in contiguous arrays, and each step and draw call is linear in
+ * the number of segments
+ */
+class RopeChain : public Rope
+{
+public:
+    RopeChain(
+        const double spring_constant,
+        const size_t segment_count);
+
+    size_t get_segment_count() const;
+
+    size_t get_particle_count() const;
+
+    Vector2 get_particle(const size_t i) const;
+
+    void set_constraint_iterations(const size_t iterations);
+
+    /**
+     * @brief advances the particles by the time stepped since they were last advanced, moving the end
+     * particles from the previous anchor points to the current ones over the chain steps
+     */
+    void update_particles();
+
+    virtual void draw(const DrawState* state) override;
+
+    virtual void post_step(const WorldState* state) override;
+
+    virtual void write_snapshot(RopeSnapshot& snapshot) const override;
+
+    virtual void read_snapshot(const RopeSnapshot& snapshot) override;
+
+protected:
+    void reset_particles();
+
+    void integrate_particles(
+        const Vector2& anchor_a,
+        const Vector2& anchor_b,
+        const double dt);
+
+    void satisfy_constraints();
+
+protected:
+    size_t segment_count;
+    size_t constraint_iterations;
+
+    bool particles_valid;
+    double time_accumulator;
+
+    Vector2 gravity;
+    Vector2 particle_point_a;
+    Vector2 particle_point_b;
+
+    std::vector<double> position_x;
+    std::vector<double> position_y;
+    std::vector<double> previous_x;
+    std::vector<double> previous_y;
+
+    bool has_draw_previous;
+    std::vector<double> draw_previous_x;
+    std::vector<double> draw_previous_y;
+
+    std::vector<float> vertices;
+};
+
+#endif // ROPE_CHAIN_H
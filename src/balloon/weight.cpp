@@ -1,22 +1,45 @@
 #include "weight.h"
 
-#include <stdexcept>
+#include <algorithm>
 
+#ifndef GIO_HEADLESS
 #include <allegro5/allegro_primitives.h>
+#endif
 
 #include <world_state.h>
 
-Weight::Weight() :
-    AeroObject(0.1, 0.1)
+Weight::Weight(RigidBodySet& body_set) :
+    AeroObject(body_set, 0.1, 0.1)
 {
     radius = 10.0;
-    mass = 25.0;
-    inertia = 1.0;
+    set_mass(25.0);
+    set_inertia(1.0);
 }
 
+double Weight::get_radius() const
+{
+    return radius;
+}
+
+BoundingBox Weight::get_bounding_box() const
+{
+    return BoundingBox::around_circle(get_position(), radius);
+}
+
+CollisionShape Weight::get_collision_shape() const
+{
+    return CollisionShape::circle(get_position(), radius);
+}
+
+#ifdef GIO_HEADLESS
+void Weight::draw(const DrawState*)
+{
+    // Nothing to draw without a display
+}
+#else
 void Weight::draw(const DrawState* state)
 {
-    const Vector2 screen_position = position - state->draw_offset;
+    const Vector2 screen_position = get_draw_position(state->interpolation_alpha) - state->draw_offset;
 
     al_draw_filled_circle(
         static_cast<float>(screen_position.x),
@@ -24,41 +47,29 @@ void Weight::draw(const DrawState* state)
         static_cast<float>(radius),
         al_map_rgb(123, 79, 44));
 }
+#endif
 
-void Weight::pre_step(const StepState* state)
+void Weight::apply_forces(const WorldState* state)
 {
     // Run any super items
-    AeroObject::pre_step(state);
+    AeroObject::apply_forces(state);
+
+    // Find the contact between the weight and the terrain, if any
+    ContactManifold manifold;
+    gio::collide_heightfield(get_collision_shape(), *state->terrain, manifold);
 
-    const WorldState* world_state = dynamic_cast<const WorldState*>(state);
-    if (world_state == nullptr)
+    if (manifold.count == 0)
     {
-        throw std::runtime_error("world step must get a physics object for correct computations");
+        return;
     }
 
-    // Determine the elevation and surface normal of the terrain
-    const Vector2 norm = world_state->terrain->surface_normal_at_x(position.x);
-
-    // Determine the point that we are using for elevation
-    const Vector2 elev_point = Vector2(
-        position.x,
-        world_state->terrain->elevation_at_x(position.x));
-
-    // Determine the touch point that we will use for the weight object
-    const Vector2 touch_point = position - norm * radius;
+    // Push back against the terrain along the contact normal
+    const ContactPoint& contact = manifold.points[0];
+    const Vector2 velocity = get_velocity();
 
-    // Determine the distance to the ground (or that we are below the ground)
-    const double ground_dist = (touch_point - elev_point).dot(norm);
-
-    // Setup the normal force values
     Vector2 normal_force = Vector2(0.0, 0.0);
-
-    // If below the ground, apply the normal force
-    if (ground_dist < 0.0)
-    {
-        normal_force += -ground_dist * world_state->terrain->get_spring_constant() * norm;
-        normal_force += -std::min(0.0, norm.dot(velocity)) * world_state->terrain->get_damping_coefficient() * norm;
-    }
+    normal_force += contact.penetration * state->terrain->get_spring_constant() * contact.normal;
+    normal_force += -std::min(0.0, contact.normal.dot(velocity)) * state->terrain->get_damping_coefficient() * contact.normal;
 
     // Add the force to the weight
     add_force_absolute(normal_force);
@@ -2,15 +2,25 @@
 #define WEIGHT_H
 
 #include <gamelib/aero_object.h>
+#include <gamelib/bounding_box.h>
+#include <gamelib/collision.h>
 
-class Weight : public AeroObject
+#include <world_state.h>
+
+class Weight : public AeroObject<WorldState>, public Collider
 {
 public:
-    Weight();
+    explicit Weight(RigidBodySet& body_set);
 
     virtual void draw(const DrawState* state) override;
 
-    virtual void pre_step(const StepState* state) override;
+    virtual void apply_forces(const WorldState* state) override;
+
+    double get_radius() const;
+
+    BoundingBox get_bounding_box() const;
+
+    virtual CollisionShape get_collision_shape() const override;
 
 protected:
     double radius;
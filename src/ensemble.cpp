@@ -0,0 +1,226 @@
+#include "ensemble.h"
+
+#include <algorithm>
+#include <cmath>
+
+Flight::Flight(const FlightSettings& settings) :
+    settings(settings),
+    scene(settings.terrain),
+    terrain(scene.get_terrain()),
+    balloon(*scene.create_balloon(settings.start_position)),
+    autopilot(settings.autopilot)
+{
+    // Define the step state
+    world_state.input = &input_snapshot;
+    world_state.time_step = settings.time_step;
+    world_state.gravity = Vector2(0.0, 10.0);
+    world_state.integrator = settings.integrator;
+    world_state.rope_mode = settings.rope_mode;
+    world_state.terrain = &terrain;
+}
+
+void Flight::run()
+{
+    // Run the autopilot at the same rate as the game physics timer
+    const double PHYSICS_PERIOD = 1.0 / 30.0;
+    const size_t num_ticks = static_cast<size_t>(settings.seconds / PHYSICS_PERIOD);
+    const size_t num_steps = std::max<size_t>(1, static_cast<size_t>(PHYSICS_PERIOD / world_state.time_step + 0.5));
+
+    size_t ticks_in_band = 0;
+    size_t ticks_burner_on = 0;
+    size_t ticks_valve_open = 0;
+    size_t ticks_run = 0;
+    bool prev_contact = false;
+
+    stats = FlightStats();
+
+    for (size_t tick = 0; tick < num_ticks; ++tick)
+    {
+        autopilot.update(balloon, terrain);
+        input_snapshot = autopilot.get_input_manager()->take_snapshot();
+
+        for (size_t i = 0; i < num_steps; ++i)
+        {
+            scene.pre_step(&world_state);
+            scene.step(&world_state);
+            scene.post_step(&world_state);
+
+            input_snapshot.clear_rising_edges();
+        }
+
+        ++ticks_run;
+
+        // Sample the flight state at the end of the tick
+        const Gondola& gondola = balloon.get_gondola();
+        const Vector2 gondola_pos = gondola.get_position();
+        const double height_agl = terrain.elevation_at_x(gondola_pos.x) - gondola_pos.y;
+
+        if (!std::isfinite(height_agl))
+        {
+            stats.finite = false;
+            break;
+        }
+
+        if (height_agl >= settings.autopilot.low_agl && height_agl <= settings.autopilot.high_agl)
+        {
+            ++ticks_in_band;
+        }
+
+        if (balloon.get_envelope().get_burner_on())
+        {
+            ++ticks_burner_on;
+        }
+
+        if (balloon.get_envelope().get_valve_open())
+        {
+            ++ticks_valve_open;
+        }
+
+        if (tick == 0)
+        {
+            stats.min_agl = height_agl;
+            stats.max_agl = height_agl;
+        }
+        else
+        {
+            stats.min_agl = std::min(stats.min_agl, height_agl);
+            stats.max_agl = std::max(stats.max_agl, height_agl);
+        }
+
+        // Count each new touchdown of either bottom corner of the gondola
+        const GondolaCorners corners = gondola.get_corners();
+        const Vector2 bottom_left = corners.points[GondolaCorners::BOTTOM_LEFT];
+        const Vector2 bottom_right = corners.points[GondolaCorners::BOTTOM_RIGHT];
+
+        const double bottom_xs[2] = { bottom_left.x, bottom_right.x };
+        double bottom_elevations[2];
+
+        terrain.sample(bottom_xs, bottom_elevations, gio::Span<Vector2>());
+
+        const bool contact =
+            bottom_left.y >= bottom_elevations[0] ||
+            bottom_right.y >= bottom_elevations[1];
+
+        if (contact && !prev_contact)
+        {
+            ++stats.ground_contacts;
+        }
+
+        prev_contact = contact;
+    }
+
+    // Convert the tick counts into durations and fractions of the flight
+    stats.seconds = static_cast<double>(ticks_run) * PHYSICS_PERIOD;
+    stats.final_position = balloon.get_gondola().get_position();
+
+    if (ticks_run > 0)
+    {
+        const double ticks = static_cast<double>(ticks_run);
+        stats.time_in_band = static_cast<double>(ticks_in_band) / ticks;
+        stats.burner_duty = static_cast<double>(ticks_burner_on) / ticks;
+        stats.valve_duty = static_cast<double>(ticks_valve_open) / ticks;
+    }
+}
+
+const FlightSettings& Flight::get_settings() const
+{
+    return settings;
+}
+
+const FlightStats& Flight::get_stats() const
+{
+    return stats;
+}
+
+Ensemble::Ensemble(const size_t thread_count) :
+    pool(thread_count)
+{
+    // Empty Constructor
+}
+
+void Ensemble::add_flight(const FlightSettings& settings)
+{
+    flights.push_back(std::make_unique<Flight>(settings));
+}
+
+void Ensemble::clear()
+{
+    flights.clear();
+}
+
+size_t Ensemble::size() const
+{
+    return flights.size();
+}
+
+size_t Ensemble::get_thread_count() const
+{
+    return pool.get_thread_count();
+}
+
+void Ensemble::run()
+{
+    // Each flight only touches its own state, so the flights can be run in any order on any thread
+    pool.run(flights.size(), [this](const size_t i) {
+        flights[i]->run();
+    });
+}
+
+const Flight& Ensemble::get_flight(const size_t i) const
+{
+    return *flights[i];
+}
+
+EnsembleSummary Ensemble::summarize() const
+{
+    EnsembleSummary summary;
+    summary.flights = flights.size();
+
+    size_t stable_flights = 0;
+
+    for (const auto& flight : flights)
+    {
+        const FlightStats& stats = flight->get_stats();
+
+        if (!stats.finite)
+        {
+            ++summary.unstable_flights;
+            continue;
+        }
+
+        if (stable_flights == 0)
+        {
+            summary.min_time_in_band = stats.time_in_band;
+            summary.min_agl = stats.min_agl;
+            summary.max_agl = stats.max_agl;
+        }
+        else
+        {
+            summary.min_time_in_band = std::min(summary.min_time_in_band, stats.time_in_band);
+            summary.min_agl = std::min(summary.min_agl, stats.min_agl);
+            summary.max_agl = std::max(summary.max_agl, stats.max_agl);
+        }
+
+        summary.mean_time_in_band += stats.time_in_band;
+        summary.mean_burner_duty += stats.burner_duty;
+        summary.mean_valve_duty += stats.valve_duty;
+
+        summary.total_ground_contacts += stats.ground_contacts;
+        if (stats.ground_contacts > 0)
+        {
+            ++summary.flights_with_contact;
+        }
+
+        ++stable_flights;
+    }
+
+    if (stable_flights > 0)
+    {
+        const double count = static_cast<double>(stable_flights);
+        summary.mean_time_in_band /= count;
+        summary.mean_burner_duty /= count;
+        summary.mean_valve_duty /= count;
+    }
+
+    return summary;
+}
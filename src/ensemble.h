@@ -0,0 +1,143 @@
+#ifndef ENSEMBLE_H
+#define ENSEMBLE_H
+
+#include <gamelib/integrator.h>
+#include <gamelib/work_stealing_pool.h>
+
+#include <balloon/balloon.h>
+
+#include <autopilot.h>
+#include <scene.h>
+#include <terrain.h>
+#include <world_state.h>
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+/**
+ * @brief Provides the parameters for a single autopilot flight
+ */
+struct FlightSettings
+{
+    AutopilotSettings autopilot;
+    TerrainSettings terrain;
+
+    Vector2 start_position = Vector2(1280.0 / 2.0, 720.0 / 2.0);
+
+    double seconds = 60.0;
+    double time_step = 0.0001;
+
+    IntegratorType integrator = IntegratorType::SEMI_IMPLICIT_EULER;
+    RopeMode rope_mode = RopeMode::SPRING;
+};
+
+/**
+ * @brief Provides the statistics collected over a single flight, sampled once per autopilot tick
+ */
+struct FlightStats
+{
+    double seconds = 0.0;
+
+    double time_in_band = 0.0;
+    double burner_duty = 0.0;
+    double valve_duty = 0.0;
+
+    size_t ground_contacts = 0;
+
+    double min_agl = 0.0;
+    double max_agl = 0.0;
+
+    Vector2 final_position;
+    bool finite = true;
+};
+
+/**
+ * @brief Provides the statistics aggregated over every flight in an ensemble
+ */
+struct EnsembleSummary
+{
+    size_t flights = 0;
+    size_t unstable_flights = 0;
+
+    double mean_time_in_band = 0.0;
+    double min_time_in_band = 0.0;
+    double mean_burner_duty = 0.0;
+    double mean_valve_duty = 0.0;
+
+    size_t total_ground_contacts = 0;
+    size_t flights_with_contact = 0;
+
+    double min_agl = 0.0;
+    double max_agl = 0.0;
+};
+
+/**
+ * @brief Holds the full simulation state of one autopilot flight, independent of every other flight
+ */
+class Flight
+{
+public:
+    explicit Flight(const FlightSettings& settings);
+
+    /**
+     * @brief runs the flight for its full duration, at the same autopilot rate as the game physics timer
+     */
+    void run();
+
+    const FlightSettings& get_settings() const;
+
+    const FlightStats& get_stats() const;
+
+protected:
+    FlightSettings settings;
+    FlightStats stats;
+
+    Scene scene;
+    Terrain& terrain;
+    Balloon& balloon;
+    Autopilot autopilot;
+    WorldState world_state;
+    InputSnapshot input_snapshot;
+};
+
+/**
+ * @brief Runs many independent flights in parallel on a work-stealing thread pool, with one task per
+ * flight, and aggregates the statistics of each run
+ */
+class Ensemble
+{
+public:
+    /**
+     * @brief constructs an empty ensemble
+     * @param thread_count the number of threads to use, or zero for one per hardware core
+     */
+    explicit Ensemble(const size_t thread_count = 0);
+
+    void add_flight(const FlightSettings& settings);
+
+    void clear();
+
+    size_t size() const;
+
+    size_t get_thread_count() const;
+
+    /**
+     * @brief runs every flight that has been added to completion
+     */
+    void run();
+
+    const Flight& get_flight(const size_t i) const;
+
+    /**
+     * @brief aggregates the statistics of every flight
+     * @return the ensemble summary
+     */
+    EnsembleSummary summarize() const;
+
+protected:
+    WorkStealingPool pool;
+    std::vector<std::unique_ptr<Flight>> flights;
+};
+
+#endif // ENSEMBLE_H
@@ -0,0 +1,184 @@
+// Ensemble Simulation Entry Point
+
+#include <ensemble.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    /**
+     * @brief creates the perturbed flights for an ensemble, starting each flight at a random location
+     * along the terrain and a random height around the game start height
+     * @param base the settings shared by every flight
+     * @param count the number of flights to create
+     * @param seed the random seed
+     * @return the settings for each flight
+     */
+    std::vector<FlightSettings> make_flights(
+        const FlightSettings& base,
+        const size_t count,
+        const unsigned int seed)
+    {
+        std::mt19937 rng(seed);
+        std::uniform_real_distribution<double> x_dist(0.0, 20000.0);
+        std::uniform_real_distribution<double> y_dist(-50.0, 50.0);
+
+        std::vector<FlightSettings> flights(count, base);
+        for (auto& flight : flights)
+        {
+            flight.start_position = Vector2(
+                x_dist(rng),
+                base.start_position.y + y_dist(rng));
+        }
+
+        return flights;
+    }
+
+    /**
+     * @brief runs the flights on an ensemble with the given number of threads
+     * @param flights the flights to run
+     * @param thread_count the number of threads, or zero for one per hardware core
+     * @param summary set to the resulting summary
+     * @return the number of flights completed per wall-clock second
+     */
+    double run_ensemble(
+        const std::vector<FlightSettings>& flights,
+        const size_t thread_count,
+        EnsembleSummary& summary)
+    {
+        Ensemble ensemble(thread_count);
+        for (const auto& flight : flights)
+        {
+            ensemble.add_flight(flight);
+        }
+
+        const auto start_time = std::chrono::steady_clock::now();
+        ensemble.run();
+        const auto end_time = std::chrono::steady_clock::now();
+
+        summary = ensemble.summarize();
+
+        const double wall_seconds = std::chrono::duration<double>(end_time - start_time).count();
+        return static_cast<double>(flights.size()) / wall_seconds;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    // Define the default run parameters
+    FlightSettings base;
+    size_t flight_count = 64;
+    size_t thread_count = 0;
+    unsigned int seed = 1;
+    bool scaling = false;
+
+    // Parse the command line options
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "--flights") == 0 && i + 1 < argc)
+        {
+            flight_count = static_cast<size_t>(std::atol(argv[++i]));
+        }
+        else if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc)
+        {
+            thread_count = static_cast<size_t>(std::atol(argv[++i]));
+        }
+        else if (std::strcmp(argv[i], "--seconds") == 0 && i + 1 < argc)
+        {
+            base.seconds = std::atof(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--seed") == 0 && i + 1 < argc)
+        {
+            seed = static_cast<unsigned int>(std::atol(argv[++i]));
+        }
+        else if (std::strcmp(argv[i], "--integrator") == 0 && i + 1 < argc && integrator_from_name(argv[i + 1], base.integrator))
+        {
+            ++i;
+        }
+        else if (std::strcmp(argv[i], "--terrain-seed") == 0 && i + 1 < argc)
+        {
+            base.terrain.seed = std::strtoull(argv[++i], nullptr, 10);
+        }
+        else if (std::strcmp(argv[i], "--dt") == 0 && i + 1 < argc)
+        {
+            base.time_step = std::atof(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--band") == 0 && i + 2 < argc)
+        {
+            base.autopilot.low_agl = std::atof(argv[++i]);
+            base.autopilot.high_agl = std::atof(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--climb-temps") == 0 && i + 2 < argc)
+        {
+            base.autopilot.climb_burner_on_temp = std::atof(argv[++i]);
+            base.autopilot.climb_burner_off_temp = std::atof(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--scaling") == 0)
+        {
+            scaling = true;
+        }
+        else
+        {
+            std::cerr << "usage: " << argv[0] << " [--flights N] [--threads N] [--seconds N] [--seed N]"
+                << " [--integrator euler|verlet|rk4|adaptive] [--dt SECONDS] [--terrain-seed N] [--band LOW_AGL HIGH_AGL]"
+                << " [--climb-temps BURNER_ON BURNER_OFF] [--scaling]" << std::endl;
+            return 1;
+        }
+    }
+
+    const std::vector<FlightSettings> flights = make_flights(base, flight_count, seed);
+
+    if (scaling)
+    {
+        // Run the same flights with a doubling number of threads up to the core count
+        const size_t max_threads = (thread_count > 0) ? thread_count : std::max<size_t>(1, std::thread::hardware_concurrency());
+
+        std::vector<size_t> counts;
+        for (size_t count = 1; count < max_threads; count *= 2)
+        {
+            counts.push_back(count);
+        }
+        counts.push_back(max_threads);
+
+        double single_rate = 0.0;
+        for (const size_t count : counts)
+        {
+            EnsembleSummary summary;
+            const double rate = run_ensemble(flights, count, summary);
+            if (count == 1)
+            {
+                single_rate = rate;
+            }
+
+            std::cout << count << " threads: " << rate << " flights/s, speedup " << rate / single_rate
+                << ", efficiency " << rate / single_rate / static_cast<double>(count) << std::endl;
+        }
+
+        return 0;
+    }
+
+    EnsembleSummary summary;
+    const double rate = run_ensemble(flights, thread_count, summary);
+
+    // Report the aggregate flight statistics
+    std::cout << "ran " << summary.flights << " flights of " << base.seconds << " s at " << rate << " flights/s" << std::endl;
+    std::cout << "band " << base.autopilot.low_agl << "-" << base.autopilot.high_agl << " AGL: mean time in band "
+        << summary.mean_time_in_band << ", worst " << summary.min_time_in_band << std::endl;
+    std::cout << "burner duty " << summary.mean_burner_duty << ", valve duty " << summary.mean_valve_duty << std::endl;
+    std::cout << "ground contacts " << summary.total_ground_contacts << " over " << summary.flights_with_contact << " flights" << std::endl;
+    std::cout << "height range " << summary.min_agl << " to " << summary.max_agl << " AGL" << std::endl;
+
+    if (summary.unstable_flights > 0)
+    {
+        std::cout << summary.unstable_flights << " unstable flights" << std::endl;
+    }
+
+    return 0;
+}
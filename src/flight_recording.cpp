@@ -0,0 +1,246 @@
+#include "flight_recording.h"
+
+#include <gamelib/keycodes.h>
+
+#include <scene.h>
+#include <terrain.h>
+
+#include <chrono>
+#include <cstring>
+#include <sstream>
+
+namespace
+{
+    /**
+     * @brief the version of the flight metadata layout
+     */
+    const uint64_t METADATA_VERSION = 2;
+
+    /**
+     * @brief the largest terrain octave count accepted when reading, to reject corrupt settings
+     */
+    const uint64_t MAX_TERRAIN_OCTAVES = 32;
+
+    /**
+     * @brief the FNV-1a 64-bit hash parameters
+     */
+    const uint64_t FNV_OFFSET_BASIS = 0xcbf29ce484222325ull;
+    const uint64_t FNV_PRIME = 0x100000001b3ull;
+
+    /**
+     * @brief adds the exact bits of a value to an FNV-1a hash
+     * @param hash the hash to update
+     * @param value the value to add
+     */
+    void hash_double(
+        uint64_t& hash,
+        const double value)
+    {
+        uint64_t bits = 0;
+        std::memcpy(&bits, &value, sizeof(bits));
+
+        for (size_t i = 0; i < sizeof(bits); ++i)
+        {
+            hash ^= (bits >> (8 * i)) & 0xFF;
+            hash *= FNV_PRIME;
+        }
+    }
+
+    /**
+     * @brief adds the state of a physics body to an FNV-1a hash
+     * @param hash the hash to update
+     * @param body the body to add
+     */
+    void hash_body(
+        uint64_t& hash,
+        const PhysicsBody& body)
+    {
+        const Vector2 position = body.get_position();
+        const Vector2 velocity = body.get_velocity();
+
+        hash_double(hash, position.x);
+        hash_double(hash, position.y);
+        hash_double(hash, velocity.x);
+        hash_double(hash, velocity.y);
+        hash_double(hash, body.get_rotation());
+        hash_double(hash, body.get_rotational_velocity());
+    }
+}
+
+std::vector<int> flight_recording_keys()
+{
+    return {
+        ALLEGRO_KEY_UP,
+        ALLEGRO_KEY_DOWN,
+        ALLEGRO_KEY_LEFT,
+        ALLEGRO_KEY_RIGHT,
+        ALLEGRO_KEY_W,
+        ALLEGRO_KEY_S,
+        ALLEGRO_KEY_A,
+        ALLEGRO_KEY_D,
+        ALLEGRO_KEY_1,
+        ALLEGRO_KEY_2
+    };
+}
+
+std::string encode_flight_metadata(
+    const WorldState& state,
+    const TerrainSettings& terrain,
+    const Vector2& start_position)
+{
+    std::ostringstream out;
+
+    gio::write_varint(out, METADATA_VERSION);
+    gio::write_double(out, state.time_step);
+    gio::write_double(out, state.gravity.x);
+    gio::write_double(out, state.gravity.y);
+    gio::write_varint(out, state.strict_integration ? 1 : 0);
+    gio::write_varint(out, static_cast<uint64_t>(state.integrator));
+    gio::write_double(out, state.adaptive_tolerance);
+    gio::write_varint(out, static_cast<uint64_t>(state.rope_mode));
+    gio::write_double(out, start_position.x);
+    gio::write_double(out, start_position.y);
+
+    gio::write_varint(out, terrain.seed);
+    gio::write_double(out, terrain.base_height);
+    gio::write_double(out, terrain.amplitude);
+    gio::write_double(out, terrain.wavelength);
+    gio::write_varint(out, terrain.octaves);
+    gio::write_double(out, terrain.persistence);
+    gio::write_double(out, terrain.lacunarity);
+    gio::write_double(out, terrain.plateau_height);
+    gio::write_double(out, terrain.plateau_flatness);
+
+    return out.str();
+}
+
+bool decode_flight_metadata(
+    const std::string& metadata,
+    WorldState& state,
+    TerrainSettings& terrain,
+    Vector2& start_position)
+{
+    std::istringstream in(metadata);
+
+    uint64_t version = 0;
+    uint64_t strict = 0;
+    uint64_t integrator = 0;
+    uint64_t rope_mode = 0;
+    uint64_t octaves = 0;
+
+    const bool valid =
+        gio::read_varint(in, version) && version == METADATA_VERSION &&
+        gio::read_double(in, state.time_step) &&
+        gio::read_double(in, state.gravity.x) &&
+        gio::read_double(in, state.gravity.y) &&
+        gio::read_varint(in, strict) &&
+        gio::read_varint(in, integrator) &&
+        gio::read_double(in, state.adaptive_tolerance) &&
+        gio::read_varint(in, rope_mode) &&
+        gio::read_double(in, start_position.x) &&
+        gio::read_double(in, start_position.y) &&
+        gio::read_varint(in, terrain.seed) &&
+        gio::read_double(in, terrain.base_height) &&
+        gio::read_double(in, terrain.amplitude) &&
+        gio::read_double(in, terrain.wavelength) &&
+        gio::read_varint(in, octaves) &&
+        gio::read_double(in, terrain.persistence) &&
+        gio::read_double(in, terrain.lacunarity) &&
+        gio::read_double(in, terrain.plateau_height) &&
+        gio::read_double(in, terrain.plateau_flatness);
+
+    if (!valid || integrator > static_cast<uint64_t>(IntegratorType::ADAPTIVE) || rope_mode > static_cast<uint64_t>(RopeMode::CONSTRAINT) || octaves > MAX_TERRAIN_OCTAVES)
+    {
+        return false;
+    }
+
+    state.strict_integration = strict != 0;
+    state.integrator = static_cast<IntegratorType>(integrator);
+    state.rope_mode = static_cast<RopeMode>(rope_mode);
+    terrain.octaves = static_cast<size_t>(octaves);
+
+    return true;
+}
+
+uint64_t flight_state_hash(const Balloon& balloon)
+{
+    uint64_t hash = FNV_OFFSET_BASIS;
+
+    hash_body(hash, balloon.get_gondola());
+    hash_body(hash, balloon.get_envelope());
+    hash_double(hash, balloon.get_envelope().get_temp_ratio());
+
+    return hash;
+}
+
+ReplayResult replay_flight(InputRecording& recording)
+{
+    ReplayResult result;
+
+    // Setup the simulation from the recorded settings
+    WorldState world_state;
+    TerrainSettings terrain_settings;
+    Vector2 start_position;
+
+    if (!decode_flight_metadata(recording.get_metadata(), world_state, terrain_settings, start_position))
+    {
+        return result;
+    }
+
+    Scene scene(terrain_settings);
+    InputSnapshot input_snapshot;
+
+    world_state.input = &input_snapshot;
+    world_state.terrain = &scene.get_terrain();
+
+    const Balloon& balloon = *scene.create_balloon(start_position);
+
+    result.valid = true;
+    result.matched = true;
+
+    // Run each recorded step, checking each checkpoint as it is reached
+    const std::vector<InputRecording::Checkpoint>& checkpoints = recording.get_checkpoints();
+    size_t next_checkpoint = 0;
+
+    recording.rewind();
+
+    const auto start_time = std::chrono::steady_clock::now();
+
+    while (result.matched)
+    {
+        while (next_checkpoint < checkpoints.size() && checkpoints[next_checkpoint].step_index == result.steps)
+        {
+            if (flight_state_hash(balloon) != checkpoints[next_checkpoint].value)
+            {
+                result.matched = false;
+                result.divergence_step = result.steps;
+                break;
+            }
+
+            ++result.checkpoints_matched;
+            ++next_checkpoint;
+        }
+
+        if (!result.matched || !recording.has_next_step())
+        {
+            break;
+        }
+
+        recording.play_step(input_snapshot);
+
+        scene.pre_step(&world_state);
+        scene.step(&world_state);
+        scene.post_step(&world_state);
+
+        ++result.steps;
+    }
+
+    const auto end_time = std::chrono::steady_clock::now();
+
+    result.wall_seconds = std::chrono::duration<double>(end_time - start_time).count();
+    result.sim_seconds = static_cast<double>(result.steps) * world_state.time_step;
+    result.gondola_position = balloon.get_gondola().get_position();
+    result.temperature_ratio = balloon.get_envelope().get_temp_ratio();
+
+    return result;
+}
@@ -0,0 +1,83 @@
+#ifndef FLIGHT_RECORDING_H
+#define FLIGHT_RECORDING_H
+
+#include <gamelib/input_recording.h>
+#include <gamelib/vector2.h>
+
+#include <balloon/balloon.h>
+
+#include <terrain_generator.h>
+#include <world_state.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief provides the keys read by the balloon simulation, which are the keys stored in a flight recording
+ * @return the recorded keycodes
+ */
+std::vector<int> flight_recording_keys();
+
+/**
+ * @brief encodes the simulation settings, terrain and balloon start position needed to replay a flight
+ * @param state the world state the flight is run with
+ * @param terrain the settings of the terrain the flight is run over
+ * @param start_position the balloon start position passed to Balloon::set_position
+ * @return the metadata to store with the recording
+ */
+std::string encode_flight_metadata(
+    const WorldState& state,
+    const TerrainSettings& terrain,
+    const Vector2& start_position);
+
+/**
+ * @brief decodes the metadata written by encode_flight_metadata
+ * @param metadata the recording metadata
+ * @param state updated with the recorded simulation settings
+ * @param terrain set to the recorded terrain settings
+ * @param start_position set to the recorded balloon start position
+ * @return true if the metadata was valid
+ */
+bool decode_flight_metadata(
+    const std::string& metadata,
+    WorldState& state,
+    TerrainSettings& terrain,
+    Vector2& start_position);
+
+/**
+ * @brief hashes the exact bits of the gondola and envelope state, so that any difference between a
+ * recorded flight and its replay changes the checkpoint value
+ * @param balloon the balloon to hash
+ * @return the state hash
+ */
+uint64_t flight_state_hash(const Balloon& balloon);
+
+/**
+ * @brief Provides the result of replaying a flight recording
+ */
+struct ReplayResult
+{
+    bool valid = false;
+    bool matched = false;
+
+    uint64_t steps = 0;
+    size_t checkpoints_matched = 0;
+    uint64_t divergence_step = 0;
+
+    double sim_seconds = 0.0;
+    double wall_seconds = 0.0;
+
+    Vector2 gondola_position;
+    double temperature_ratio = 0.0;
+};
+
+/**
+ * @brief re-runs a recorded flight headlessly, as fast as possible, checking the state hash at every
+ * recorded checkpoint and stopping at the first mismatch
+ * @param recording the recording to replay
+ * @return the replay result
+ */
+ReplayResult replay_flight(InputRecording& recording);
+
+#endif // FLIGHT_RECORDING_H
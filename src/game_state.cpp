@@ -1,10 +1,45 @@
 #include "game_state.h"
 
+#include <flight_recording.h>
+
+#include <gamelib/trace.h>
+
 #include <allegro5/allegro_primitives.h>
 
 #include <allegro5/allegro_audio.h>
 
-GameState::GameState()
+#include <algorithm>
+#include <chrono>
+
+namespace
+{
+    /**
+     * @brief the fixed physics substep, in seconds
+     */
+    const double PHYSICS_TIME_STEP = 0.0001;
+
+    /**
+     * @brief the number of physics periods that a single late step may catch up by default
+     */
+    const double MAX_CATCH_UP_PERIODS = 3.0;
+
+    /**
+     * @brief provides the time between two clock readings in seconds
+     */
+    double seconds_between(
+        const std::chrono::steady_clock::time_point start,
+        const std::chrono::steady_clock::time_point end)
+    {
+        return std::chrono::duration<double>(end - start).count();
+    }
+}
+
+GameState::GameState() :
+    perf_timing(false),
+    step_accumulator(PHYSICS_TIME_STEP, 0),
+    dropped_time(0.0),
+    limited_step_count(0),
+    physics_running(false)
 {
     // Define the draw state
     draw_state.draw_offset = Vector2();
@@ -13,30 +48,46 @@ GameState::GameState()
     draw_state.screen_w = 1280;
     draw_state.screen_h = 720;
 
-    // Set the balloon position
-    balloon.set_position(
+    // Create the balloon in the scene
+    balloon = scene.create_balloon(Vector2(
+        static_cast<double>(draw_state.screen_w) / 2.0,
+        static_cast<double>(draw_state.screen_h) / 2.0));
+    render_balloon.set_position(
         static_cast<double>(draw_state.screen_w) / 2.0,
         static_cast<double>(draw_state.screen_h) / 2.0);
 
     // Define the step state
-    world_state.input_manager = &input_manager_autopilot;
-    world_state.time_step = 0.0001;
+    world_state.time_step = PHYSICS_TIME_STEP;
     world_state.gravity = Vector2(0.0, 10.0);
-    world_state.terrain = &terrain;
+    world_state.terrain = &scene.get_terrain();
+    physics = std::make_unique<PhysicsStepper>(scene, *balloon, world_state);
+
+    // Limit each step to a few periods of substeps by default
+    set_step_budget(static_cast<size_t>(MAX_CATCH_UP_PERIODS * physics_period / world_state.time_step + 0.5));
 
     // Add the terrain as a draw object
-    draw_objects.push_back(&terrain);
+    draw_objects.push_back(&scene.get_terrain());
+    perf_hud.add_draw_object("terrain");
+
+    // Add the balloon parameters, drawing the copy updated from the published snapshots
+    draw_objects.push_back(&render_balloon);
+    perf_hud.add_draw_object("balloon");
 
-    // Add the balloon parameters
-    draw_objects.push_back(&balloon);
-    step_objects.push_back(&balloon);
+    // Time the menu alongside the draw objects
+    menu_timer_index = perf_hud.add_draw_object("menu");
+}
+
+GameState::~GameState()
+{
+    stop_physics_thread();
 }
 
 bool GameState::init()
 {
     return
         sound_manager.init() &&
-        menu_state_flow.init(&draw_state);
+        menu_state_flow.init(&draw_state) &&
+        perf_hud.init();
 }
 
 void GameState::set_display(ALLEGRO_DISPLAY* display)
@@ -84,6 +135,18 @@ InputManager* GameState::get_input_manager()
     return &input_manager;
 }
 
+void GameState::key_down(const int keycode)
+{
+    input_manager.set_key_down(keycode);
+    physics->queue_key_event(keycode, true);
+}
+
+void GameState::key_up(const int keycode)
+{
+    input_manager.set_key_up(keycode);
+    physics->queue_key_event(keycode, false);
+}
+
 SoundManager* GameState::get_sound_manager()
 {
     return &sound_manager;
@@ -91,11 +154,46 @@ SoundManager* GameState::get_sound_manager()
 
 void GameState::draw()
 {
+    GIO_TRACE_SCOPE("GameState::draw");
+
+    using Clock = std::chrono::steady_clock;
+
+    // Only read the clock for the performance overlay while it is shown
+    const bool measure = perf_hud.get_visible();
+    const Clock::time_point draw_start = measure ? Clock::now() : Clock::time_point();
+
+    // Take the newest published balloon state, if any
+    if (snapshots.update())
+    {
+        const FrameSnapshot& snapshot = snapshots.read_buffer();
+        render_balloon.read_snapshot(snapshot.balloon);
+        snapshot_time = snapshot.publish_time;
+    }
+
+    // Take the timings of every physics step since the last frame, including steps whose snapshots
+    // were replaced before being drawn, so that the slowest steps are not missed
+    StepTimings timings;
+    while (step_timings.pop(timings))
+    {
+        perf_hud.add_step_timings(timings);
+    }
+
+    // Determine how far to draw between the previous and newest states, based on the time since the newest was published
+    if (frame_interpolation)
+    {
+        const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - snapshot_time).count();
+        draw_state.interpolation_alpha = std::min(std::max(elapsed / physics_period, 0.0), 1.0);
+    }
+    else
+    {
+        draw_state.interpolation_alpha = 1.0;
+    }
+
     // Update the sound volume based on menu state
     sound_manager.set_sound_gain(menu_state_flow.in_menu() ? 0.25 : 1.0);
 
     // Update the window offset if needed
-    const Vector2 diff_val = balloon.get_gondola().get_position() - draw_state.draw_offset;
+    const Vector2 diff_val = render_balloon.get_gondola().get_draw_position(draw_state.interpolation_alpha) - draw_state.draw_offset;
 
     const double display_width = static_cast<double>(draw_state.screen_w);
     const double display_height = static_cast<double>(draw_state.screen_h);
@@ -133,19 +231,40 @@ void GameState::draw()
     al_clear_to_color(background_color);
 
     // Run all drawable parameters
-    for (auto& it : draw_objects)
+    for (size_t i = 0; i < draw_objects.size(); ++i)
     {
-        it->draw(&draw_state);
+        const Clock::time_point object_start = measure ? Clock::now() : Clock::time_point();
+
+        draw_objects[i]->draw(&draw_state);
+
+        if (measure)
+        {
+            perf_hud.add_draw_time(i, seconds_between(object_start, Clock::now()));
+        }
     }
 
     // Draw the menu if needed
     if (menu_state_flow.in_menu())
     {
+        const Clock::time_point menu_start = measure ? Clock::now() : Clock::time_point();
+
         menu_state_flow.draw(&draw_state);
+
+        if (measure)
+        {
+            perf_hud.add_draw_time(menu_timer_index, seconds_between(menu_start, Clock::now()));
+        }
     }
 
+    // Draw the performance overlay over everything else, measuring the frame up to this point
+    const Clock::time_point draw_end = measure ? Clock::now() : Clock::time_point();
+    perf_hud.draw(&draw_state);
+
     // Flip the screen
-    al_flip_display();
+    {
+        GIO_TRACE_SCOPE("al_flip_display");
+        al_flip_display();
+    }
 
     // Check for a button press to stop any music
     if (input_manager.get_key_rising_edge(ALLEGRO_KEY_M))
@@ -166,83 +285,158 @@ void GameState::draw()
         }
     }
 
+    // Let the physics step know whether the autopilot is flying
+    physics->set_autopilot_enabled(menu_state_flow.in_menu());
+
     // Update sounds
-    sound_manager.set_burner_state(balloon.get_envelope().get_burner_on() ? SoundManager::BurnerState::ON : SoundManager::BurnerState::OFF);
-    sound_manager.set_valve_state(balloon.get_envelope().get_valve_open() ? SoundManager::ValveState::OPEN : SoundManager::ValveState::CLOSED);
+    const Clock::time_point audio_start = measure ? Clock::now() : Clock::time_point();
+
+    sound_manager.set_burner_state(render_balloon.get_envelope().get_burner_on() ? SoundManager::BurnerState::ON : SoundManager::BurnerState::OFF);
+    sound_manager.set_valve_state(render_balloon.get_envelope().get_valve_open() ? SoundManager::ValveState::OPEN : SoundManager::ValveState::CLOSED);
     sound_manager.update_background();
+
+    // Record the frame totals, leaving out the display flip which waits for the screen
+    const size_t tile_update_count = scene.get_terrain().get_tile_update_count();
+
+    if (measure)
+    {
+        perf_hud.add_frame(
+            seconds_between(draw_start, draw_end),
+            seconds_between(audio_start, Clock::now()),
+            tile_update_count - prev_tile_update_count);
+        perf_hud.set_dropped_time(get_dropped_time());
+    }
+
+    prev_tile_update_count = tile_update_count;
+
+    // Show or hide the performance overlay, letting the physics step know whether to measure itself
+    if (input_manager.get_key_rising_edge(ALLEGRO_KEY_F3))
+    {
+        perf_hud.toggle();
+        perf_timing = perf_hud.get_visible();
+    }
+}
+
+void GameState::set_frame_interpolation(const bool enabled)
+{
+    frame_interpolation = enabled;
+}
+
+bool GameState::start_recording(const std::string& path)
+{
+    recording_file.open(path, std::ios::binary);
+    if (!recording_file)
+    {
+        return false;
+    }
+
+    // Record from the current balloon position, which is the start position before the first step
+    recorder = std::make_unique<InputRecorder>(
+        recording_file,
+        flight_recording_keys(),
+        encode_flight_metadata(world_state, scene.get_terrain().get_settings(), balloon->get_gondola().get_position()));
+    physics->set_recorder(recorder.get());
+
+    return true;
+}
+
+void GameState::set_step_budget(const size_t max_substeps)
+{
+    step_accumulator.set_max_steps(max_substeps);
+}
+
+double GameState::get_dropped_time() const
+{
+    return dropped_time.load();
+}
+
+size_t GameState::get_limited_step_count() const
+{
+    return limited_step_count.load();
 }
 
 void GameState::step(const double dt)
 {
-    // Determine the number of incremental steps to run
-    const size_t num_steps = static_cast<size_t>(dt / world_state.time_step);
+    GIO_TRACE_SCOPE("GameState::step");
 
-    // Update the autopilot if needed
-    if (menu_state_flow.in_menu())
+    // Determine the number of incremental steps to run, carrying any remainder to the next step
+    const size_t num_steps = step_accumulator.advance(dt);
+    dropped_time.store(step_accumulator.get_dropped_time());
+
+    // Mark each step cut short by the step budget in the trace, since it drops simulation time
+    if (step_accumulator.get_limited_frame_count() != limited_step_count.load())
     {
-        // Determine position state parameters
-        const Vector2 gondola_pos = balloon.get_gondola().get_position();
-        const double height_agl = terrain.elevation_at_x(gondola_pos.x) - gondola_pos.y;
-        const double temp_percent = balloon.get_envelope().get_temp_ratio();
+        GIO_TRACE_INSTANT("step budget limited");
+        limited_step_count.store(step_accumulator.get_limited_frame_count());
+    }
 
-        // Perform bang-bang control
-        if (height_agl < 290)
-        {
-            input_manager_autopilot.set_key_up(ALLEGRO_KEY_DOWN);
-
-            if (temp_percent < 0.9)
-            {
-                input_manager_autopilot.set_key_down(ALLEGRO_KEY_UP);
-            }
-            else if (temp_percent > 0.95)
-            {
-                input_manager_autopilot.set_key_up(ALLEGRO_KEY_UP);
-            }
-        }
-        else if (height_agl > 310)
-        {
-            if (temp_percent < 0.6)
-            {
-                input_manager_autopilot.set_key_up(ALLEGRO_KEY_DOWN);
-            }
-            else if (temp_percent > 0.8)
-            {
-                input_manager_autopilot.set_key_down(ALLEGRO_KEY_DOWN);
-            }
-
-            if (temp_percent < 0.5)
-            {
-                input_manager_autopilot.set_key_down(ALLEGRO_KEY_UP);
-            }
-            else if (temp_percent > 0.75)
-            {
-                input_manager_autopilot.set_key_up(ALLEGRO_KEY_UP);
-            }
-        }
+    // Run the substeps, measuring each phase only while the performance overlay is shown
+    const StepTimings timings = physics->tick(num_steps, perf_timing.load(std::memory_order_relaxed));
+
+    // Publish the resulting state to be drawn
+    FrameSnapshot& snapshot = snapshots.write_buffer();
+    balloon->write_snapshot(snapshot.balloon);
+    snapshot.publish_time = std::chrono::steady_clock::now();
+    snapshots.publish();
+
+    // Pass the timings to the overlay separately from the snapshots, which skip any not yet drawn
+    if (timings.valid)
+    {
+        step_timings.push(timings);
     }
-    else
+}
+
+void GameState::start_physics_thread(const double period)
+{
+    if (physics_running)
     {
-        world_state.input_manager = get_input_manager();
+        return;
     }
 
-    // Run through the timestep to perform the integration in smaller timesteps
-    // to help maintain system stability
-    for (size_t i = 0; i < num_steps; ++i)
+    physics_period = period;
+    physics_running = true;
+    physics_thread = std::thread(&GameState::physics_loop, this, period);
+}
+
+void GameState::stop_physics_thread()
+{
+    physics_running = false;
+
+    if (physics_thread.joinable())
     {
-        // Run each pre, step, and post function
-        for (auto& it : step_objects)
-        {
-            it->pre_step(&world_state);
-        }
+        physics_thread.join();
+    }
+}
+
+void GameState::physics_loop(const double period)
+{
+    GIO_TRACE_THREAD_NAME("physics");
 
-        for (auto& it : step_objects)
+    using Clock = std::chrono::steady_clock;
+
+    const Clock::duration tick = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(period));
+    Clock::time_point next_tick = Clock::now() + tick;
+
+    // Treat the first step as taking a single period
+    Clock::time_point prev_step_time = Clock::now() - tick;
+
+    while (physics_running)
+    {
+        // Step by the time that has actually passed, so that a late tick is caught up within the step budget
+        const Clock::time_point step_time = Clock::now();
+        step(std::chrono::duration<double>(step_time - prev_step_time).count());
+        prev_step_time = step_time;
+
+        // Wait for the next tick, or start again immediately if the step overran
+        const Clock::time_point now = Clock::now();
+        if (now < next_tick)
         {
-            it->step(&world_state);
+            std::this_thread::sleep_until(next_tick);
+            next_tick += tick;
         }
-
-        for (auto& it : step_objects)
+        else
         {
-            it->post_step(&world_state);
+            next_tick = now + tick;
         }
     }
 }
@@ -1,12 +1,20 @@
 #ifndef GAME_STATE_H
 #define GAME_STATE_H
 
+#include <atomic>
+#include <chrono>
+#include <fstream>
 #include <memory>
+#include <string>
+#include <thread>
 #include <vector>
 
+#include <gamelib/fixed_step_accumulator.h>
 #include <gamelib/input_manager.h>
+#include <gamelib/input_recording.h>
 #include <gamelib/draw_object.h>
-#include <gamelib/step_object.h>
+#include <gamelib/spsc_ring.h>
+#include <gamelib/triple_buffer.h>
 
 #include <allegro5/allegro.h>
 
@@ -15,6 +23,9 @@
 #include <terrain.h>
 #include <world_state.h>
 #include <menu_state_flow.h>
+#include <perf_hud.h>
+#include <physics_stepper.h>
+#include <scene.h>
 
 #include <sound_manager.h>
 
@@ -29,6 +40,11 @@ public:
      */
     GameState();
 
+    /**
+     * @brief Stops the physics thread if it is running
+     */
+    ~GameState();
+
     /**
      * @brief Initializes any non-constructor init items
      * @return true if successfully initialized
@@ -80,6 +96,18 @@ public:
      */
     InputManager* get_input_manager();
 
+    /**
+     * @brief marks the given key as pressed for both the game and the physics step
+     * @param keycode the keycode to set
+     */
+    void key_down(const int keycode);
+
+    /**
+     * @brief marks the given key as released for both the game and the physics step
+     * @param keycode the keycode to set
+     */
+    void key_up(const int keycode);
+
     /**
      * @brief provides the core sound manager for the game state
      * @return a poionter to the sound manager
@@ -92,19 +120,84 @@ public:
     void draw();
 
     /**
-     * @brief runs the step algorithm for all steppable parameters
+     * @brief sets whether draw interpolates between the previous and newest published physics states.
+     * Drawing interpolated shows the state one physics period behind, but moves smoothly when frames
+     * are drawn more often than the physics steps
+     * @param enabled true to interpolate, false to draw the newest state
+     */
+    void set_frame_interpolation(const bool enabled);
+
+    /**
+     * @brief starts recording the input used by each physics step to a file, so that the flight can
+     * be replayed headlessly with balloon_headless --replay. Must be called before the first step
+     * @param path the file to record to
+     * @return true if the recording was started
+     */
+    bool start_recording(const std::string& path);
+
+    /**
+     * @brief sets the most physics substeps run by a single step call, so that a late step cannot take
+     * longer and longer to catch up. Any time beyond the budget is dropped. Must be called before the
+     * physics thread is started
+     * @param max_substeps the substep budget, or 0 for no limit
+     */
+    void set_step_budget(const size_t max_substeps);
+
+    /**
+     * @brief provides the total simulation time dropped because steps needed more substeps than the
+     * budget allows
+     * @return the dropped time, in seconds
+     */
+    double get_dropped_time() const;
+
+    /**
+     * @brief provides the number of steps that needed more substeps than the budget allows
+     * @return the step count
+     */
+    size_t get_limited_step_count() const;
+
+    /**
+     * @brief runs the step algorithm for all steppable parameters, and publishes the resulting state
+     * to be drawn. The delta time is added to the time carried from previous calls and run as whole
+     * substeps, up to the step budget
      * @param dt provides the delta time since the last step call
      */
     void step(const double dt);
 
+    /**
+     * @brief starts stepping the physics on its own thread at a fixed period, so that slow draw calls
+     * do not delay the physics and the physics can run on a separate core
+     * @param period the time between physics steps, in seconds
+     */
+    void start_physics_thread(const double period);
+
+    /**
+     * @brief stops the physics thread and waits for the current step to finish
+     */
+    void stop_physics_thread();
+
+private:
+    /**
+     * @brief a published balloon state and the time it was published
+     */
+    struct FrameSnapshot
+    {
+        BalloonSnapshot balloon;
+        std::chrono::steady_clock::time_point publish_time;
+    };
+
+    /**
+     * @brief the loop run by the physics thread
+     * @param period the time between physics steps, in seconds
+     */
+    void physics_loop(const double period);
+
 private:
     std::vector<DrawObject*> draw_objects;
-    std::vector<StepObject*> step_objects;
 
     bool running = true;
 
     InputManager input_manager;
-    InputManager input_manager_autopilot;
 
     SoundManager sound_manager;
 
@@ -113,9 +206,34 @@ private:
 
     MenuStateFlow menu_state_flow;
 
-    Terrain terrain;
+    PerfHud perf_hud;
+    std::atomic<bool> perf_timing;
+    SpscRing<StepTimings, PerfHud::SAMPLE_COUNT> step_timings;
+    size_t menu_timer_index;
+    size_t prev_tile_update_count = 0;
+
+    Scene scene;
+
+    Balloon* balloon;
+    Balloon render_balloon;
+
+    std::unique_ptr<PhysicsStepper> physics;
+
+    TripleBuffer<FrameSnapshot> snapshots;
+
+    FixedStepAccumulator step_accumulator;
+    std::atomic<double> dropped_time;
+    std::atomic<size_t> limited_step_count;
+
+    bool frame_interpolation = false;
+    double physics_period = 1.0 / 30.0;
+    std::chrono::steady_clock::time_point snapshot_time;
+
+    std::atomic<bool> physics_running;
+    std::thread physics_thread;
 
-    Balloon balloon;
+    std::ofstream recording_file;
+    std::unique_ptr<InputRecorder> recorder;
 };
 
 #endif // BALLOON_GAME_STATE_H
@@ -0,0 +1,265 @@
+// Headless Simulation Entry Point
+
+#include <balloon/balloon.h>
+
+#include <gamelib/integrator.h>
+#include <gamelib/trace.h>
+
+#include <autopilot.h>
+#include <flight_recording.h>
+#include <scene.h>
+#include <terrain.h>
+#include <world_state.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <memory>
+
+int main(int argc, char** argv)
+{
+    // Define the default run parameters
+    double sim_seconds = 60.0;
+    bool strict_integration = true;
+    IntegratorType integrator = IntegratorType::SEMI_IMPLICIT_EULER;
+    double time_step = 0.0001;
+    RopeMode rope_mode = RopeMode::SPRING;
+    TerrainSettings terrain_settings;
+    const char* record_path = nullptr;
+    const char* replay_path = nullptr;
+    const char* trace_path = nullptr;
+    size_t balloon_count = 1;
+
+    // Parse the command line options
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "--seconds") == 0 && i + 1 < argc)
+        {
+            sim_seconds = std::atof(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--integrator") == 0 && i + 1 < argc && integrator_from_name(argv[i + 1], integrator))
+        {
+            ++i;
+        }
+        else if (std::strcmp(argv[i], "--dt") == 0 && i + 1 < argc)
+        {
+            time_step = std::atof(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--ropes") == 0 && i + 1 < argc && std::strcmp(argv[i + 1], "spring") == 0)
+        {
+            rope_mode = RopeMode::SPRING;
+            ++i;
+        }
+        else if (std::strcmp(argv[i], "--ropes") == 0 && i + 1 < argc && std::strcmp(argv[i + 1], "constraint") == 0)
+        {
+            rope_mode = RopeMode::CONSTRAINT;
+            ++i;
+        }
+        else if (std::strcmp(argv[i], "--terrain-seed") == 0 && i + 1 < argc)
+        {
+            terrain_settings.seed = std::strtoull(argv[++i], nullptr, 10);
+        }
+        else if (std::strcmp(argv[i], "--balloons") == 0 && i + 1 < argc && std::atoi(argv[i + 1]) > 0)
+        {
+            balloon_count = static_cast<size_t>(std::atoi(argv[++i]));
+        }
+        else if (std::strcmp(argv[i], "--fast") == 0)
+        {
+            strict_integration = false;
+        }
+        else if (std::strcmp(argv[i], "--record") == 0 && i + 1 < argc)
+        {
+            record_path = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--replay") == 0 && i + 1 < argc)
+        {
+            replay_path = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--trace") == 0 && i + 1 < argc)
+        {
+            trace_path = argv[++i];
+        }
+        else
+        {
+            std::cerr << "usage: " << argv[0] << " [--seconds N] [--integrator euler|verlet|rk4|adaptive] [--dt SECONDS] [--ropes spring|constraint] [--terrain-seed N] [--balloons N] [--fast] [--record FILE | --replay FILE] [--trace FILE]" << std::endl;
+            return 1;
+        }
+    }
+
+    // Recordings only hold the flight of a single balloon
+    if (balloon_count > 1 && (record_path != nullptr || replay_path != nullptr))
+    {
+        std::cerr << "--balloons cannot be combined with --record or --replay" << std::endl;
+        return 1;
+    }
+
+    // Trace each tick if requested, which needs a build with tracing enabled
+    if (trace_path != nullptr)
+    {
+#ifdef GIO_TRACE
+        if (!gio::start_trace(trace_path))
+        {
+            std::cerr << "unable to open " << trace_path << " for tracing" << std::endl;
+            return 1;
+        }
+
+        GIO_TRACE_THREAD_NAME("main");
+#else
+        std::cerr << "--trace needs a build configured with -DGIO_ENABLE_TRACING=ON" << std::endl;
+        return 1;
+#endif
+    }
+
+    // Replay a recorded flight instead of flying the autopilot if requested
+    if (replay_path != nullptr)
+    {
+        std::ifstream replay_file(replay_path, std::ios::binary);
+        InputRecording recording;
+
+        if (!replay_file || !recording.read(replay_file))
+        {
+            std::cerr << "unable to read recording " << replay_path << std::endl;
+            return 1;
+        }
+
+        const ReplayResult result = replay_flight(recording);
+        if (!result.valid)
+        {
+            std::cerr << "unsupported recording settings in " << replay_path << std::endl;
+            return 1;
+        }
+
+        std::cout << "replayed " << result.sim_seconds << " s (" << result.steps << " substeps) in " << result.wall_seconds << " s" << std::endl;
+        std::cout << "gondola position " << result.gondola_position.x << ", " << result.gondola_position.y << std::endl;
+        std::cout << "envelope temperature ratio " << result.temperature_ratio << std::endl;
+
+        if (!result.matched)
+        {
+            std::cout << "replay diverged at substep " << result.divergence_step << " after " << result.checkpoints_matched << " matching checkpoints" << std::endl;
+            return 1;
+        }
+
+        std::cout << "replay matched all " << result.checkpoints_matched << " checkpoints" << std::endl;
+        return 0;
+    }
+
+    // Define the simulation objects
+    Scene scene(terrain_settings);
+    Autopilot autopilot;
+
+    Terrain& terrain = scene.get_terrain();
+
+    // Start the lead balloon at the same location as the game, with any others spread out to its right.
+    // Every balloon flies with the inputs the autopilot chooses for the lead balloon
+    const double BALLOON_SPACING = 300.0;
+
+    scene.reserve(balloon_count, 0, 0);
+
+    Balloon& balloon = *scene.create_balloon(Vector2(
+        1280.0 / 2.0,
+        720.0 / 2.0));
+
+    for (size_t i = 1; i < balloon_count; ++i)
+    {
+        scene.create_balloon(Vector2(
+            1280.0 / 2.0 + BALLOON_SPACING * static_cast<double>(i),
+            720.0 / 2.0));
+    }
+
+    // Define the step state
+    InputSnapshot input_snapshot;
+
+    WorldState world_state;
+    world_state.input = &input_snapshot;
+    world_state.time_step = time_step;
+    world_state.gravity = Vector2(0.0, 10.0);
+    world_state.strict_integration = strict_integration;
+    world_state.integrator = integrator;
+    world_state.rope_mode = rope_mode;
+    world_state.terrain = &terrain;
+
+    // Record the flight inputs with a state checkpoint after every tick if requested
+    std::ofstream record_file;
+    std::unique_ptr<InputRecorder> recorder;
+
+    if (record_path != nullptr)
+    {
+        record_file.open(record_path, std::ios::binary);
+        if (!record_file)
+        {
+            std::cerr << "unable to open " << record_path << " for recording" << std::endl;
+            return 1;
+        }
+
+        recorder = std::make_unique<InputRecorder>(
+            record_file,
+            flight_recording_keys(),
+            encode_flight_metadata(world_state, terrain.get_settings(), Vector2(1280.0 / 2.0, 720.0 / 2.0)));
+    }
+
+    // Run the autopilot at the same rate as the game physics timer
+    const double PHYSICS_PERIOD = 1.0 / 30.0;
+    const size_t num_ticks = static_cast<size_t>(sim_seconds / PHYSICS_PERIOD);
+    const size_t num_steps = std::max<size_t>(1, static_cast<size_t>(PHYSICS_PERIOD / world_state.time_step + 0.5));
+
+    const auto start_time = std::chrono::steady_clock::now();
+
+    for (size_t tick = 0; tick < num_ticks; ++tick)
+    {
+        GIO_TRACE_SCOPE("tick");
+
+        autopilot.update(balloon, terrain);
+        input_snapshot = autopilot.get_input_manager()->take_snapshot();
+
+        for (size_t i = 0; i < num_steps; ++i)
+        {
+            if (recorder)
+            {
+                recorder->record_step(input_snapshot);
+            }
+
+            scene.pre_step(&world_state);
+            scene.step(&world_state);
+            scene.post_step(&world_state);
+
+            input_snapshot.clear_rising_edges();
+        }
+
+        if (recorder)
+        {
+            recorder->record_checkpoint(flight_state_hash(balloon));
+        }
+    }
+
+    if (recorder)
+    {
+        recorder->finish();
+    }
+
+    gio::stop_trace();
+    if (gio::get_trace_dropped_count() > 0)
+    {
+        std::cerr << "trace dropped " << gio::get_trace_dropped_count() << " events" << std::endl;
+    }
+
+    const auto end_time = std::chrono::steady_clock::now();
+    const double wall_seconds = std::chrono::duration<double>(end_time - start_time).count();
+
+    // Report the final state and the simulation rate
+    const Vector2 gondola_pos = balloon.get_gondola().get_position();
+
+    std::cout << "simulated " << static_cast<double>(num_ticks) * PHYSICS_PERIOD << " s"
+        << " (" << num_ticks * num_steps << " " << integrator_name(integrator) << " substeps) in " << wall_seconds << " s";
+    if (balloon_count > 1)
+    {
+        std::cout << " for " << balloon_count << " balloons";
+    }
+    std::cout << std::endl;
+    std::cout << "gondola position " << gondola_pos.x << ", " << gondola_pos.y << std::endl;
+    std::cout << "envelope temperature ratio " << balloon.get_envelope().get_temp_ratio() << std::endl;
+
+    return 0;
+}
@@ -7,8 +7,12 @@
 #include <allegro5/allegro_font.h>
 #include <allegro5/allegro_ttf.h>
 
+#include <gamelib/trace.h>
+
 #include <game_state.h>
 
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
 
 ALLEGRO_DISPLAY* create_display(
@@ -63,8 +67,56 @@ ALLEGRO_DISPLAY* create_display(
     return display;
 }
 
-int main()
+int main(int argc, char** argv)
 {
+    // Parse the command line options
+    const char* record_path = nullptr;
+    const char* trace_path = nullptr;
+    double frame_rate = 0.0;
+    int max_substeps = -1;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "--record") == 0 && i + 1 < argc)
+        {
+            record_path = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--fps") == 0 && i + 1 < argc && std::atof(argv[i + 1]) > 0.0)
+        {
+            frame_rate = std::atof(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--max-substeps") == 0 && i + 1 < argc && std::atoi(argv[i + 1]) >= 0)
+        {
+            max_substeps = std::atoi(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--trace") == 0 && i + 1 < argc)
+        {
+            trace_path = argv[++i];
+        }
+        else
+        {
+            std::cerr << "usage: " << argv[0] << " [--record FILE] [--fps RATE] [--max-substeps N] [--trace FILE]" << std::endl;
+            return 1;
+        }
+    }
+
+    // Start tracing before anything is loaded if requested, which needs a build with tracing enabled
+    if (trace_path != nullptr)
+    {
+#ifdef GIO_TRACE
+        if (!gio::start_trace(trace_path))
+        {
+            std::cerr << "Unable to open " << trace_path << " for tracing" << std::endl;
+            return 1;
+        }
+
+        GIO_TRACE_THREAD_NAME("main");
+#else
+        std::cerr << "--trace needs a build configured with -DGIO_ENABLE_TRACING=ON" << std::endl;
+        return 1;
+#endif
+    }
+
     // Initialize the Allegro library
     if (!al_init())
     {
@@ -118,12 +170,12 @@ int main()
     ALLEGRO_TRANSFORM display_transform;
     ALLEGRO_DISPLAY* display = nullptr;
 
-    // Create framerate and physics timers
-    const double FRAME_PERIOD = 1.0 / 30.0;
+    // Create the framerate timer, while the physics runs on its own thread at a fixed period. A
+    // requested frame rate draws interpolated states, so that it can exceed the physics rate
+    const double FRAME_PERIOD = frame_rate > 0.0 ? 1.0 / frame_rate : 1.0 / 30.0;
     const double PHYSICS_PERIOD = 1.0 / 30.0;
 
     ALLEGRO_TIMER* frame_timer = al_create_timer(FRAME_PERIOD);
-    ALLEGRO_TIMER* physics_timer = al_create_timer(PHYSICS_PERIOD);
 
     // Define a voice to use for playing audio
     ALLEGRO_VOICE* main_voice = al_create_voice(
@@ -157,6 +209,21 @@ int main()
             state.set_quit();
         }
 
+        // Interpolate between physics states when pacing frames at a requested rate
+        state.set_frame_interpolation(frame_rate > 0.0);
+
+        // Limit the substeps a late physics step may catch up if requested, where 0 removes the limit
+        if (max_substeps >= 0)
+        {
+            state.set_step_budget(static_cast<size_t>(max_substeps));
+        }
+
+        // Start recording before the first step if requested
+        if (record_path != nullptr && !state.start_recording(record_path))
+        {
+            std::cerr << "Unable to open " << record_path << " for recording" << std::endl;
+        }
+
         // Assign the default mixer
         al_set_default_mixer(state.get_sound_manager()->get_mixer());
         al_attach_mixer_to_voice(state.get_sound_manager()->get_mixer(), main_voice);
@@ -164,17 +231,14 @@ int main()
         // Parameter to check for game events
         ALLEGRO_EVENT game_event;
 
-        // Start Timers
+        // Start the timer and the physics thread
         al_start_timer(frame_timer);
-        al_start_timer(physics_timer);
+        state.start_physics_thread(PHYSICS_PERIOD);
 
         // Register event sources
         al_register_event_source(
             event_queue,
             al_get_timer_event_source(frame_timer));
-        al_register_event_source(
-            event_queue,
-            al_get_timer_event_source(physics_timer));
         al_register_event_source(
             event_queue,
             al_get_keyboard_event_source());
@@ -185,6 +249,8 @@ int main()
             // Wait for the next event
             al_wait_for_event(event_queue, &game_event);
 
+            GIO_TRACE_SCOPE("main_event");
+
             // Check each event type
             switch (game_event.type)
             {
@@ -192,21 +258,18 @@ int main()
                 state.set_quit();
                 break;
             case ALLEGRO_EVENT_TIMER:
-                if (game_event.timer.source == physics_timer)
-                {
-                    // Run physics step
-                    state.step(PHYSICS_PERIOD);
-                }
-                else if (game_event.timer.source == frame_timer)
+                if (game_event.timer.source == frame_timer)
                 {
                     // Run frame step
                     state.draw();
                 }
                 break;
             case ALLEGRO_EVENT_KEY_DOWN:
-                state.get_input_manager()->set_key_down(game_event.keyboard.keycode);
+                state.key_down(game_event.keyboard.keycode);
                 if (state.get_input_manager()->get_key_rising_edge(ALLEGRO_KEY_F))
                 {
+                    GIO_TRACE_SCOPE("toggle_fullscreen");
+
                     // Stop Timers
                     al_pause_event_queue(event_queue, true);
                     al_flush_event_queue(event_queue);
@@ -238,30 +301,45 @@ int main()
                 }
                 break;
             case ALLEGRO_EVENT_KEY_UP:
-                state.get_input_manager()->set_key_up(game_event.keyboard.keycode);
+                state.key_up(game_event.keyboard.keycode);
                 break;
             default:
                 break;
             }
         }
+
+        // Stop the physics before the game state is destroyed
+        state.stop_physics_thread();
+
+        // Report any simulation time that late physics steps could not catch up
+        if (state.get_limited_step_count() > 0)
+        {
+            std::cout << "dropped " << state.get_dropped_time() << " s of simulation time over "
+                << state.get_limited_step_count() << " late physics steps" << std::endl;
+        }
     }
 
     // Destory objects and null pointers
     al_destroy_display(display);
     al_destroy_event_queue(event_queue);
     al_destroy_timer(frame_timer);
-    al_destroy_timer(physics_timer);
     al_destroy_voice(main_voice);
 
     display = nullptr;
     event_queue = nullptr;
     frame_timer = nullptr;
-    physics_timer = nullptr;
 
     // Uninstall add-ons
     al_uninstall_audio();
     al_uninstall_keyboard();
 
+    // Write out the trace, if one was started
+    gio::stop_trace();
+    if (gio::get_trace_dropped_count() > 0)
+    {
+        std::cerr << "Trace dropped " << gio::get_trace_dropped_count() << " events" << std::endl;
+    }
+
     // Return success
     return 0;
 }
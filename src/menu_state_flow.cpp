@@ -5,6 +5,8 @@
 #include <allegro5/allegro_font.h>
 #include <allegro5/allegro_ttf.h>
 
+#include <gamelib/trace.h>
+
 #include <vector>
 #include <string>
 #include <fstream>
@@ -22,6 +24,8 @@ MenuStateFlow::MenuStateFlow()
 
 bool MenuStateFlow::init(const DrawState* state)
 {
+    GIO_TRACE_SCOPE("MenuStateFlow::init");
+
     // Define the font filename
     static const char* FONT_FILE_NAME = "fonts/tuffy.ttf";
 
@@ -141,6 +145,7 @@ bool MenuStateFlow::draw_help(const DrawState* state)
         "Press 2 to Release/Connect Right Weight",
         "Press F to Toggle Windowed / Fullscreen",
         "Press M to Toggle Music",
+        "Press F3 to Toggle Performance Overlay",
         "",
         "Press B to Return to Main Menu"
     };
@@ -157,6 +162,7 @@ bool MenuStateFlow::draw_credits(const DrawState* state)
     // Define the main lines
     std::vector<std::string> main_help;
 
+    GIO_TRACE_SCOPE("MenuStateFlow::load_credits");
     std::ifstream credits_input("music/credits.txt");
 
     std::string line;
@@ -0,0 +1,206 @@
+#include "perf_hud.h"
+
+#include <allegro5/allegro.h>
+#include <allegro5/allegro_primitives.h>
+
+namespace
+{
+    /**
+     * @brief the size of the overlay panel and its text layout, in pixels
+     */
+    const float PANEL_X = 10.0f;
+    const float PANEL_Y = 10.0f;
+    const float PANEL_WIDTH = 420.0f;
+    const float TEXT_MARGIN = 8.0f;
+    const float LINE_SPACING = 1.4f;
+
+    /**
+     * @brief the fraction used for the tail timing shown next to each average
+     */
+    const double TAIL_FRACTION = 0.99;
+}
+
+PerfHud::PerfHud() :
+    visible(false),
+    font(nullptr),
+    draw_object_count(0),
+    dropped_time(0.0)
+{
+    draw_object_names.fill(nullptr);
+}
+
+bool PerfHud::init()
+{
+    if (font == nullptr)
+    {
+        font = al_create_builtin_font();
+    }
+
+    return font != nullptr;
+}
+
+void PerfHud::toggle()
+{
+    visible = !visible;
+
+    if (visible)
+    {
+        step_total.clear();
+        pre_step.clear();
+        step.clear();
+        post_step.clear();
+        substeps.clear();
+
+        draw_total.clear();
+        audio.clear();
+        terrain_rebuilds.clear();
+
+        for (Samples& samples : draw_object_times)
+        {
+            samples.clear();
+        }
+    }
+}
+
+bool PerfHud::get_visible() const
+{
+    return visible;
+}
+
+size_t PerfHud::add_draw_object(const char* name)
+{
+    if (draw_object_count >= MAX_DRAW_OBJECTS)
+    {
+        return MAX_DRAW_OBJECTS;
+    }
+
+    draw_object_names[draw_object_count] = name;
+    return draw_object_count++;
+}
+
+void PerfHud::add_step_timings(const StepTimings& timings)
+{
+    if (!timings.valid)
+    {
+        return;
+    }
+
+    step_total.add(timings.pre_step + timings.step + timings.post_step);
+    pre_step.add(timings.pre_step);
+    step.add(timings.step);
+    post_step.add(timings.post_step);
+    substeps.add(static_cast<double>(timings.substeps));
+}
+
+void PerfHud::add_draw_time(
+    const size_t index,
+    const double seconds)
+{
+    if (index < draw_object_count)
+    {
+        draw_object_times[index].add(seconds);
+    }
+}
+
+void PerfHud::add_frame(
+    const double draw_seconds,
+    const double audio_seconds,
+    const size_t terrain_rebuilds)
+{
+    draw_total.add(draw_seconds);
+    audio.add(audio_seconds);
+    this->terrain_rebuilds.add(static_cast<double>(terrain_rebuilds));
+}
+
+void PerfHud::set_dropped_time(const double seconds)
+{
+    dropped_time = seconds;
+}
+
+void PerfHud::draw(const DrawState*)
+{
+    if (!visible || font == nullptr)
+    {
+        return;
+    }
+
+    const float line_height = LINE_SPACING * static_cast<float>(al_get_font_line_height(font));
+    const size_t line_count = 10 + draw_object_count;
+
+    // Darken the panel behind the text so that it can be read over the sky and terrain
+    al_draw_filled_rectangle(
+        PANEL_X,
+        PANEL_Y,
+        PANEL_X + PANEL_WIDTH,
+        PANEL_Y + 2.0f * TEXT_MARGIN + line_height * static_cast<float>(line_count),
+        al_map_rgba(0, 0, 0, 160));
+
+    float y = PANEL_Y + TEXT_MARGIN;
+
+    al_draw_textf(font, al_map_rgb(255, 255, 255), PANEL_X + TEXT_MARGIN, y, 0, "%-18s %9s %9s", "", "avg ms", "p99 ms");
+    y += line_height;
+
+    draw_timing("physics step", step_total, y);
+    draw_timing("  pre_step", pre_step, y);
+    draw_timing("  step", step, y);
+    draw_timing("  post_step", post_step, y);
+    draw_count("substeps/step", substeps, y);
+
+    draw_timing("draw", draw_total, y);
+    for (size_t i = 0; i < draw_object_count; ++i)
+    {
+        draw_timing(draw_object_names[i], draw_object_times[i], y);
+    }
+
+    draw_timing("audio", audio, y);
+    draw_count("terrain rebuilds", terrain_rebuilds, y);
+
+    al_draw_textf(font, al_map_rgb(255, 255, 255), PANEL_X + TEXT_MARGIN, y, 0, "%-18s %9.3f s", "dropped sim time", dropped_time);
+}
+
+void PerfHud::draw_timing(
+    const char* label,
+    const Samples& samples,
+    float& y)
+{
+    al_draw_textf(
+        font,
+        al_map_rgb(255, 255, 255),
+        PANEL_X + TEXT_MARGIN,
+        y,
+        0,
+        "%-18s %9.3f %9.3f",
+        label,
+        samples.average() * 1000.0,
+        samples.percentile(TAIL_FRACTION) * 1000.0);
+
+    y += LINE_SPACING * static_cast<float>(al_get_font_line_height(font));
+}
+
+void PerfHud::draw_count(
+    const char* label,
+    const Samples& samples,
+    float& y)
+{
+    al_draw_textf(
+        font,
+        al_map_rgb(255, 255, 255),
+        PANEL_X + TEXT_MARGIN,
+        y,
+        0,
+        "%-18s %9.1f %9.1f",
+        label,
+        samples.average(),
+        samples.percentile(TAIL_FRACTION));
+
+    y += LINE_SPACING * static_cast<float>(al_get_font_line_height(font));
+}
+
+PerfHud::~PerfHud()
+{
+    if (font != nullptr)
+    {
+        al_destroy_font(font);
+        font = nullptr;
+    }
+}
@@ -0,0 +1,135 @@
+#ifndef PERF_HUD_H
+#define PERF_HUD_H
+
+#include <gamelib/draw_object.h>
+#include <gamelib/sample_ring.h>
+
+#include <allegro5/allegro_font.h>
+
+#include <step_timings.h>
+
+#include <array>
+#include <cstddef>
+
+/**
+ * @brief Collects frame and physics step timings and draws them as an overlay, toggled with F3. Each
+ * measurement is kept in a fixed-size SampleRing so that collecting never allocates, and is shown as
+ * the rolling average and 99th percentile. Callers only need to measure while the overlay is visible
+ */
+class PerfHud : public DrawObject
+{
+public:
+    /**
+     * @brief the most draw objects that can be timed separately
+     */
+    static const size_t MAX_DRAW_OBJECTS = 8;
+
+    /**
+     * @brief the number of samples held for each measurement, covering several seconds of frames
+     */
+    static const size_t SAMPLE_COUNT = 256;
+
+    PerfHud();
+
+    /**
+     * @brief creates the overlay font
+     * @return true if successful
+     */
+    bool init();
+
+    /**
+     * @brief shows or hides the overlay, clearing the samples when shown so that it starts fresh
+     */
+    void toggle();
+
+    /**
+     * @brief determines if the overlay is shown, and so whether timings should be measured
+     * @return true if shown
+     */
+    bool get_visible() const;
+
+    /**
+     * @brief adds a draw object to be timed, to be called while setting up
+     * @param name the label to show, which must outlive the overlay
+     * @return the index to give add_draw_time, or MAX_DRAW_OBJECTS if no more can be added
+     */
+    size_t add_draw_object(const char* name);
+
+    /**
+     * @brief adds the timings of a physics step
+     * @param timings the step timings, which are ignored if not valid
+     */
+    void add_step_timings(const StepTimings& timings);
+
+    /**
+     * @brief adds the time taken to draw a single draw object
+     * @param index the index returned by add_draw_object
+     * @param seconds the draw time
+     */
+    void add_draw_time(
+        const size_t index,
+        const double seconds);
+
+    /**
+     * @brief adds the totals of a drawn frame
+     * @param draw_seconds the time taken by the whole draw call
+     * @param audio_seconds the time taken to update the sounds
+     * @param terrain_rebuilds the number of terrain tile bitmaps redrawn
+     */
+    void add_frame(
+        const double draw_seconds,
+        const double audio_seconds,
+        const size_t terrain_rebuilds);
+
+    /**
+     * @brief sets the simulation time dropped by late physics steps so far
+     * @param seconds the dropped time
+     */
+    void set_dropped_time(const double seconds);
+
+    virtual void draw(const DrawState* state) override;
+
+    ~PerfHud();
+
+protected:
+    using Samples = SampleRing<SAMPLE_COUNT>;
+
+    /**
+     * @brief draws a line with the average and 99th percentile of a timing, in milliseconds
+     */
+    void draw_timing(
+        const char* label,
+        const Samples& samples,
+        float& y);
+
+    /**
+     * @brief draws a line with the average and 99th percentile of a count
+     */
+    void draw_count(
+        const char* label,
+        const Samples& samples,
+        float& y);
+
+protected:
+    bool visible;
+
+    ALLEGRO_FONT* font;
+
+    Samples step_total;
+    Samples pre_step;
+    Samples step;
+    Samples post_step;
+    Samples substeps;
+
+    Samples draw_total;
+    Samples audio;
+    Samples terrain_rebuilds;
+
+    std::array<const char*, MAX_DRAW_OBJECTS> draw_object_names;
+    std::array<Samples, MAX_DRAW_OBJECTS> draw_object_times;
+    size_t draw_object_count;
+
+    double dropped_time;
+};
+
+#endif // PERF_HUD_H
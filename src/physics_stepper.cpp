@@ -0,0 +1,143 @@
+#include "physics_stepper.h"
+
+#include <flight_recording.h>
+
+#include <gamelib/trace.h>
+
+#include <chrono>
+
+namespace
+{
+    /**
+     * @brief provides the time between two clock readings in seconds
+     */
+    double seconds_between(
+        const std::chrono::steady_clock::time_point start,
+        const std::chrono::steady_clock::time_point end)
+    {
+        return std::chrono::duration<double>(end - start).count();
+    }
+}
+
+PhysicsStepper::PhysicsStepper(
+    Scene& scene,
+    Balloon& balloon,
+    WorldState& world_state) :
+    scene(scene),
+    balloon(balloon),
+    world_state(world_state),
+    autopilot_enabled(true),
+    recorder(nullptr)
+{
+    world_state.input = &input_snapshot;
+}
+
+void PhysicsStepper::queue_key_event(
+    const int keycode,
+    const bool down)
+{
+    std::lock_guard<std::mutex> lock(input_mutex);
+    pending_key_events.push_back({ keycode, down });
+}
+
+void PhysicsStepper::set_autopilot_enabled(const bool enabled)
+{
+    autopilot_enabled = enabled;
+}
+
+void PhysicsStepper::set_recorder(InputRecorder* recorder)
+{
+    this->recorder = recorder;
+}
+
+StepTimings PhysicsStepper::tick(
+    const size_t num_steps,
+    const bool measure)
+{
+    GIO_TRACE_SCOPE("PhysicsStepper::tick");
+
+    // Take any key events received since the last tick
+    apply_pending_input();
+
+    // Update the autopilot if needed, and freeze the key state read by every substep of the tick
+    if (autopilot_enabled)
+    {
+        autopilot.update(balloon, scene.get_terrain());
+        input_snapshot = autopilot.get_input_manager()->take_snapshot();
+    }
+    else
+    {
+        input_snapshot = input_manager.take_snapshot();
+    }
+
+    // Measure each phase only if asked
+    using Clock = std::chrono::steady_clock;
+
+    StepTimings timings;
+    timings.valid = measure;
+    timings.substeps = num_steps;
+
+    // Run through the timestep to perform the integration in smaller timesteps
+    // to help maintain system stability
+    for (size_t i = 0; i < num_steps; ++i)
+    {
+        // Record the input for the step if needed
+        if (recorder != nullptr)
+        {
+            recorder->record_step(input_snapshot);
+        }
+
+        // Run each pre, step, and post function
+        const Clock::time_point pre_step_start = measure ? Clock::now() : Clock::time_point();
+        scene.pre_step(&world_state);
+
+        const Clock::time_point step_start = measure ? Clock::now() : Clock::time_point();
+        scene.step(&world_state);
+
+        const Clock::time_point post_step_start = measure ? Clock::now() : Clock::time_point();
+        scene.post_step(&world_state);
+
+        if (measure)
+        {
+            const Clock::time_point post_step_end = Clock::now();
+
+            timings.pre_step += seconds_between(pre_step_start, step_start);
+            timings.step += seconds_between(step_start, post_step_start);
+            timings.post_step += seconds_between(post_step_start, post_step_end);
+        }
+
+        // Deliver each rising edge to the first substep only
+        input_snapshot.clear_rising_edges();
+    }
+
+    // Record the resulting state so that a replay can check that it matches
+    if (recorder != nullptr)
+    {
+        recorder->record_checkpoint(flight_state_hash(balloon));
+    }
+
+    return timings;
+}
+
+void PhysicsStepper::apply_pending_input()
+{
+    // Swap the pending events out under the lock so that the game thread is only blocked briefly
+    {
+        std::lock_guard<std::mutex> lock(input_mutex);
+        applied_key_events.swap(pending_key_events);
+    }
+
+    for (const KeyEvent& event : applied_key_events)
+    {
+        if (event.down)
+        {
+            input_manager.set_key_down(event.keycode);
+        }
+        else
+        {
+            input_manager.set_key_up(event.keycode);
+        }
+    }
+
+    applied_key_events.clear();
+}
@@ -0,0 +1,108 @@
+#ifndef PHYSICS_STEPPER_H
+#define PHYSICS_STEPPER_H
+
+#include <gamelib/input_manager.h>
+#include <gamelib/input_recording.h>
+#include <gamelib/input_snapshot.h>
+
+#include <balloon/balloon.h>
+
+#include <autopilot.h>
+#include <scene.h>
+#include <step_timings.h>
+#include <world_state.h>
+
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+/**
+ * @brief Runs the physics ticks of a scene flown by the player or the autopilot. Each tick applies the
+ * key events forwarded from the game thread, freezes the key state read by its substeps, and runs the
+ * substeps, recording the input if needed. The game and the allocation check in balloon_bench both
+ * step through this class, so that the check covers the same code the game runs
+ */
+class PhysicsStepper
+{
+public:
+    /**
+     * @brief constructs the stepper, pointing the world state input at the frozen key state
+     * @param scene the scene to step
+     * @param balloon the balloon flown by the player or the autopilot
+     * @param world_state the world state to step with, which must outlive the stepper
+     */
+    PhysicsStepper(
+        Scene& scene,
+        Balloon& balloon,
+        WorldState& world_state);
+
+    PhysicsStepper(const PhysicsStepper&) = delete;
+    PhysicsStepper& operator=(const PhysicsStepper&) = delete;
+
+    /**
+     * @brief forwards a key event to the next tick, and may be called from any thread
+     * @param keycode the keycode of the key
+     * @param down true if the key was pressed, false if released
+     */
+    void queue_key_event(
+        const int keycode,
+        const bool down);
+
+    /**
+     * @brief sets whether the autopilot flies the balloon rather than the player, and may be called
+     * from any thread
+     * @param enabled true to fly with the autopilot
+     */
+    void set_autopilot_enabled(const bool enabled);
+
+    /**
+     * @brief sets the recorder to write the input of each substep and the state hash of each tick to
+     * @param recorder the recorder, or nullptr to stop recording, which must outlive its use
+     */
+    void set_recorder(InputRecorder* recorder);
+
+    /**
+     * @brief runs a physics tick
+     * @param num_steps the number of substeps to run
+     * @param measure true to time each phase of the substeps
+     * @return the time spent in each phase, which is only valid if measured
+     */
+    StepTimings tick(
+        const size_t num_steps,
+        const bool measure);
+
+private:
+    /**
+     * @brief a key event forwarded from the game thread to the physics step
+     */
+    struct KeyEvent
+    {
+        int keycode;
+        bool down;
+    };
+
+    /**
+     * @brief applies the key events received since the last tick to the physics input manager
+     */
+    void apply_pending_input();
+
+private:
+    Scene& scene;
+    Balloon& balloon;
+    WorldState& world_state;
+
+    InputManager input_manager;
+
+    std::mutex input_mutex;
+    std::vector<KeyEvent> pending_key_events;
+    std::vector<KeyEvent> applied_key_events;
+
+    std::atomic<bool> autopilot_enabled;
+    Autopilot autopilot;
+
+    InputSnapshot input_snapshot;
+    InputRecorder* recorder;
+};
+
+#endif // PHYSICS_STEPPER_H
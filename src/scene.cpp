@@ -0,0 +1,369 @@
+#include "scene.h"
+
+#include <numeric>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+    /**
+     * @brief the spring constant given to scene ropes, which matches the balloon ropes
+     */
+    const double ROPE_SPRING_CONSTANT = 100.0;
+
+    /**
+     * @brief the number of position solves made for the scene ropes after each step
+     */
+    const size_t ROPE_POSITION_ITERATIONS = 2;
+
+    /**
+     * @brief converts a global point to the frame of a body
+     */
+    Vector2 to_local(
+        const PhysicsBody* body,
+        const Vector2& point)
+    {
+        return (point - body->get_position()).rotate_rad(-body->get_rotation());
+    }
+
+    /**
+     * @brief converts a point in the frame of a body to a global point
+     */
+    Vector2 to_global(
+        const PhysicsBody* body,
+        const Vector2& point)
+    {
+        return body->get_position() + point.rotate_rad(body->get_rotation());
+    }
+}
+
+SceneWeight::SceneWeight() :
+    weight(bodies)
+{
+    // Empty Constructor
+}
+
+SceneRope::SceneRope(const size_t segment_count) :
+    rope(ROPE_SPRING_CONSTANT, segment_count)
+{
+    // Empty Constructor
+}
+
+Scene::Scene() :
+    colliders_changed(false),
+    ropes_changed(false)
+{
+    // Empty Constructor
+}
+
+Scene::Scene(const TerrainSettings& terrain_settings) :
+    terrain(terrain_settings),
+    colliders_changed(false),
+    ropes_changed(false)
+{
+    // Empty Constructor
+}
+
+Terrain& Scene::get_terrain()
+{
+    return terrain;
+}
+
+void Scene::reserve(
+    const size_t balloon_count,
+    const size_t weight_count,
+    const size_t rope_count)
+{
+    balloons.reserve(balloon_count);
+    weights.reserve(weight_count);
+    ropes.reserve(rope_count);
+}
+
+Balloon* Scene::create_balloon(const Vector2& position)
+{
+    Balloon* balloon = balloons.create();
+    balloon->set_position(position.x, position.y);
+
+    colliders_changed = true;
+    return balloon;
+}
+
+void Scene::destroy_balloon(Balloon* balloon)
+{
+    if (balloon == nullptr)
+    {
+        return;
+    }
+
+    destroy_ropes_where([balloon](const PhysicsBody* body) { return balloon->contains_body(body); });
+
+    balloons.destroy(balloon);
+    colliders_changed = true;
+}
+
+SceneWeight* Scene::create_weight(const Vector2& position)
+{
+    SceneWeight* weight = weights.create();
+    weight->weight.set_position(position);
+
+    colliders_changed = true;
+    return weight;
+}
+
+void Scene::destroy_weight(SceneWeight* weight)
+{
+    if (weight == nullptr)
+    {
+        return;
+    }
+
+    destroy_ropes_where([weight](const PhysicsBody* body) { return body == &weight->weight; });
+
+    weights.destroy(weight);
+    colliders_changed = true;
+}
+
+SceneRope* Scene::create_rope(
+    PhysicsBody* body_a,
+    const Vector2& point_a,
+    PhysicsBody* body_b,
+    const Vector2& point_b,
+    const size_t segment_count)
+{
+    SceneRope* rope = ropes.create(segment_count);
+
+    rope->body_a = body_a;
+    rope->body_b = body_b;
+    rope->local_a = to_local(body_a, point_a);
+    rope->local_b = to_local(body_b, point_b);
+
+    // Hold the rope at its starting length, which must be set after the objects
+    rope->rope.set_object_a(body_a);
+    rope->rope.set_object_b(body_b);
+    rope->rope.set_point_a(point_a);
+    rope->rope.set_point_b(point_b);
+    rope->rope.set_init_length(point_a.distance_to(point_b));
+
+    ropes_changed = true;
+    return rope;
+}
+
+void Scene::destroy_rope(SceneRope* rope)
+{
+    ropes.destroy(rope);
+    ropes_changed = true;
+}
+
+size_t Scene::get_balloon_count() const
+{
+    return balloons.size();
+}
+
+size_t Scene::get_weight_count() const
+{
+    return weights.size();
+}
+
+size_t Scene::get_rope_count() const
+{
+    return ropes.size();
+}
+
+const CollisionWorld& Scene::get_collision_world() const
+{
+    return collision_world;
+}
+
+void Scene::draw(const DrawState* state)
+{
+    terrain.draw(state);
+
+    ropes.for_each([state](SceneRope& rope) { rope.rope.draw(state); });
+    weights.for_each([state](SceneWeight& weight) { weight.weight.draw(state); });
+    balloons.for_each([state](Balloon& balloon) { balloon.draw(state); });
+}
+
+void Scene::pre_step(const WorldState* state)
+{
+    update_colliders();
+
+    balloons.for_each([state](Balloon& balloon) { balloon.pre_step(state); });
+    weights.for_each([state](SceneWeight& weight) { weight.weight.pre_step(state); });
+}
+
+void Scene::step(const WorldState* state)
+{
+    // Step each balloon, which integrates its own bodies
+    balloons.for_each([state](Balloon& balloon) { balloon.step(state); });
+
+    // Integrate each loose weight, creating the integrator requested by the world state if needed
+    weights.for_each([state](SceneWeight& weight)
+    {
+        weight.weight.step(state);
+
+        if (weight.integrator == nullptr || weight.integrator->get_type() != state->integrator)
+        {
+            weight.integrator = Integrator::create(state->integrator);
+        }
+
+        weight.integrator->integrate(
+            weight.bodies,
+            *state,
+            [&weight, state](const double)
+            {
+                weight.bodies.reset_forces();
+                weight.weight.apply_forces(state);
+            });
+    });
+
+    // Separate any bodies that have collided during the step
+    collision_world.resolve();
+
+    // Pull the ropes back within their lengths, repeating the position solve for the changed anchor points
+    if (ropes.size() > 0)
+    {
+        update_rope_groups();
+
+        for (size_t i = 0; i < ROPE_POSITION_ITERATIONS; ++i)
+        {
+            collect_rope_constraints();
+            for (DistanceConstraintSolver& solver : rope_solvers)
+            {
+                solver.solve_positions();
+            }
+        }
+
+        collect_rope_constraints();
+        for (DistanceConstraintSolver& solver : rope_solvers)
+        {
+            solver.solve_velocities();
+        }
+    }
+}
+
+void Scene::post_step(const WorldState* state)
+{
+    balloons.for_each([state](Balloon& balloon) { balloon.post_step(state); });
+    weights.for_each([state](SceneWeight& weight) { weight.weight.post_step(state); });
+
+    update_rope_points();
+    ropes.for_each([state](SceneRope& rope) { rope.rope.post_step(state); });
+}
+
+void Scene::update_colliders()
+{
+    if (!colliders_changed)
+    {
+        return;
+    }
+
+    // Register every entity again in the same order as the pools, so that contacts are found in a fixed order
+    collision_world.clear();
+
+    CollisionWorld& world = collision_world;
+    balloons.for_each([&world](Balloon& balloon) { balloon.add_colliders(world); });
+    weights.for_each([&world](SceneWeight& weight) { world.add(&weight.weight, &weight.weight); });
+
+    colliders_changed = false;
+}
+
+void Scene::update_rope_points()
+{
+    ropes.for_each([](SceneRope& rope)
+    {
+        rope.rope.set_point_a(to_global(rope.body_a, rope.local_a));
+        rope.rope.set_point_b(to_global(rope.body_b, rope.local_b));
+    });
+}
+
+void Scene::update_rope_groups()
+{
+    if (!ropes_changed)
+    {
+        return;
+    }
+
+    std::vector<SceneRope*> rope_list;
+    ropes.for_each([&rope_list](SceneRope& rope) { rope_list.push_back(&rope); });
+
+    // Join each rope with the first rope found on either of its bodies, using a disjoint set forest
+    std::vector<size_t> parents(rope_list.size());
+    std::iota(parents.begin(), parents.end(), size_t(0));
+
+    const auto find_root = [&parents](size_t index)
+    {
+        while (parents[index] != index)
+        {
+            parents[index] = parents[parents[index]];
+            index = parents[index];
+        }
+        return index;
+    };
+
+    std::unordered_map<const PhysicsBody*, size_t> body_ropes;
+
+    for (size_t i = 0; i < rope_list.size(); ++i)
+    {
+        for (const PhysicsBody* body : { rope_list[i]->body_a, rope_list[i]->body_b })
+        {
+            const auto inserted = body_ropes.emplace(body, i);
+            if (!inserted.second)
+            {
+                parents[find_root(i)] = find_root(inserted.first->second);
+            }
+        }
+    }
+
+    // Number the groups in pool order, so that the groups are always solved in the same order
+    std::vector<size_t> root_groups(rope_list.size(), rope_list.size());
+    size_t group_count = 0;
+
+    for (size_t i = 0; i < rope_list.size(); ++i)
+    {
+        const size_t root = find_root(i);
+        if (root_groups[root] == rope_list.size())
+        {
+            root_groups[root] = group_count++;
+        }
+
+        rope_list[i]->group = root_groups[root];
+    }
+
+    rope_solvers.resize(group_count);
+    ropes_changed = false;
+}
+
+void Scene::collect_rope_constraints()
+{
+    update_rope_points();
+
+    for (DistanceConstraintSolver& solver : rope_solvers)
+    {
+        solver.clear();
+    }
+
+    std::vector<DistanceConstraintSolver>& solvers = rope_solvers;
+    ropes.for_each([&solvers](const SceneRope& rope) { rope.rope.add_constraint(solvers[rope.group]); });
+}
+
+template <typename Check>
+void Scene::destroy_ropes_where(Check attached)
+{
+    // Collect the ropes first, since the pool cannot be changed while visiting it
+    std::vector<SceneRope*> attached_ropes;
+
+    ropes.for_each([&attached_ropes, &attached](SceneRope& rope)
+    {
+        if (attached(rope.body_a) || attached(rope.body_b))
+        {
+            attached_ropes.push_back(&rope);
+        }
+    });
+
+    for (SceneRope* rope : attached_ropes)
+    {
+        ropes.destroy(rope);
+    }
+
+    ropes_changed = ropes_changed || !attached_ropes.empty();
+}
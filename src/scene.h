@@ -0,0 +1,215 @@
+#ifndef SCENE_H
+#define SCENE_H
+
+#include <gamelib/collision_world.h>
+#include <gamelib/distance_constraint.h>
+#include <gamelib/game_object.h>
+#include <gamelib/integrator.h>
+#include <gamelib/object_pool.h>
+#include <gamelib/rigid_body_set.h>
+#include <gamelib/vector2.h>
+
+#include <balloon/balloon.h>
+#include <balloon/rope_chain.h>
+#include <balloon/weight.h>
+
+#include <terrain.h>
+#include <terrain_generator.h>
+#include <world_state.h>
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+/**
+ * @brief a weight that is not part of a balloon, integrated on its own
+ */
+struct SceneWeight
+{
+    SceneWeight();
+
+    // The weight body points into the body set, so the weight cannot move
+    SceneWeight(const SceneWeight&) = delete;
+    SceneWeight(SceneWeight&&) = delete;
+    SceneWeight& operator=(const SceneWeight&) = delete;
+    SceneWeight& operator=(SceneWeight&&) = delete;
+
+    RigidBodySet bodies;
+    Weight weight;
+
+    std::unique_ptr<Integrator> integrator;
+};
+
+/**
+ * @brief a rope tying two bodies of the scene together at anchor points fixed to each body
+ */
+struct SceneRope
+{
+    explicit SceneRope(const size_t segment_count);
+
+    RopeChain rope;
+
+    PhysicsBody* body_a = nullptr;
+    PhysicsBody* body_b = nullptr;
+
+    Vector2 local_a;
+    Vector2 local_b;
+
+    // The group of ropes joined to this one through shared bodies, which are solved together
+    size_t group = 0;
+};
+
+/**
+ * @brief Owns the terrain and any number of balloons, loose weights and ropes, and steps them together.
+ * Each kind of entity is kept in an ObjectPool, so that entities can be created and destroyed at runtime
+ * without moving the others, and stepping the scene does not allocate. After every entity has been
+ * stepped the scene separates colliding bodies and pulls its ropes back within their lengths, with the
+ * ropes always solved as constraints so that they can tie together bodies from different balloons. Ropes
+ * that share no bodies cannot affect each other, so each connected group of ropes is solved on its own
+ */
+class Scene : public GameObject<WorldState>
+{
+public:
+    /**
+     * @brief constructs an empty scene over the default terrain
+     */
+    Scene();
+
+    /**
+     * @brief constructs an empty scene
+     * @param terrain_settings the settings of the terrain to generate
+     */
+    explicit Scene(const TerrainSettings& terrain_settings);
+
+    Terrain& get_terrain();
+
+    /**
+     * @brief allocates room for the given number of entities, so that creating them does not grow the pools
+     * @param balloon_count the number of balloons
+     * @param weight_count the number of loose weights
+     * @param rope_count the number of ropes
+     */
+    void reserve(
+        const size_t balloon_count,
+        const size_t weight_count,
+        const size_t rope_count);
+
+    /**
+     * @brief creates a balloon
+     * @param position the gondola position, as passed to Balloon::set_position
+     * @return the new balloon, owned by the scene
+     */
+    Balloon* create_balloon(const Vector2& position);
+
+    /**
+     * @brief destroys a balloon and any ropes tied to it
+     * @param balloon the balloon to destroy
+     */
+    void destroy_balloon(Balloon* balloon);
+
+    /**
+     * @brief creates a loose weight
+     * @param position the weight position
+     * @return the new weight, owned by the scene
+     */
+    SceneWeight* create_weight(const Vector2& position);
+
+    /**
+     * @brief destroys a loose weight and any ropes tied to it
+     * @param weight the weight to destroy
+     */
+    void destroy_weight(SceneWeight* weight);
+
+    /**
+     * @brief creates a rope between two bodies, with its length set to the current distance between the points
+     * @param body_a the first body, which must belong to the scene
+     * @param point_a the anchor point on the first body, in global coordinates
+     * @param body_b the second body, which must belong to the scene
+     * @param point_b the anchor point on the second body, in global coordinates
+     * @param segment_count the number of segments drawn along the rope
+     * @return the new rope, owned by the scene
+     */
+    SceneRope* create_rope(
+        PhysicsBody* body_a,
+        const Vector2& point_a,
+        PhysicsBody* body_b,
+        const Vector2& point_b,
+        const size_t segment_count = 8);
+
+    /**
+     * @brief destroys a rope
+     * @param rope the rope to destroy
+     */
+    void destroy_rope(SceneRope* rope);
+
+    size_t get_balloon_count() const;
+
+    size_t get_weight_count() const;
+
+    size_t get_rope_count() const;
+
+    /**
+     * @brief calls a function with each balloon, in a fixed order
+     * @param function the function to call with a reference to each balloon
+     */
+    template <typename Function>
+    void for_each_balloon(Function function)
+    {
+        balloons.for_each(function);
+    }
+
+    const CollisionWorld& get_collision_world() const;
+
+    virtual void draw(const DrawState* state) override;
+
+    virtual void pre_step(const WorldState* state) override;
+
+    virtual void step(const WorldState* state) override;
+
+    virtual void post_step(const WorldState* state) override;
+
+protected:
+    /**
+     * @brief registers the bodies of every entity with the collision world again if any entity has
+     * been created or destroyed
+     */
+    void update_colliders();
+
+    /**
+     * @brief moves the rope points to the current anchor points
+     */
+    void update_rope_points();
+
+    /**
+     * @brief splits the ropes into groups connected through shared bodies again if any rope has been
+     * created or destroyed, with a solver for each group
+     */
+    void update_rope_groups();
+
+    /**
+     * @brief adds the constraint of each rope to the solver of its group at the current anchor points
+     */
+    void collect_rope_constraints();
+
+    /**
+     * @brief destroys each rope tied to a body accepted by the given check
+     * @param attached the check, given each rope body
+     */
+    template <typename Check>
+    void destroy_ropes_where(Check attached);
+
+protected:
+    Terrain terrain;
+
+    ObjectPool<Balloon> balloons;
+    ObjectPool<SceneWeight> weights;
+    ObjectPool<SceneRope> ropes;
+
+    CollisionWorld collision_world;
+    bool colliders_changed;
+
+    std::vector<DistanceConstraintSolver> rope_solvers;
+    bool ropes_changed;
+};
+
+#endif // SCENE_H
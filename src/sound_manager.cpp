@@ -1,5 +1,7 @@
 #include "sound_manager.h"
 
+#include <gamelib/trace.h>
+
 SoundManager::SoundManager() :
     inited(false),
     init_success(false),
@@ -40,6 +42,8 @@ SoundManager::SoundManager() :
 
 ALLEGRO_SAMPLE_INSTANCE* SoundManager::load_sample_data(const char* filename)
 {
+    GIO_TRACE_SCOPE("SoundManager::load_sample_data");
+
     // Load the sample data and check that it is valid
     ALLEGRO_SAMPLE* sample_data = al_load_sample(filename);
 
@@ -72,6 +76,8 @@ ALLEGRO_SAMPLE_INSTANCE* SoundManager::load_sample_data(const char* filename)
 
 ALLEGRO_AUDIO_STREAM* SoundManager::load_audio_stream(const char* filename)
 {
+    GIO_TRACE_SCOPE("SoundManager::load_audio_stream");
+
     ALLEGRO_AUDIO_STREAM* stream = al_load_audio_stream(filename, 4, 2048);
     if (stream != nullptr)
     {
@@ -222,6 +228,8 @@ void SoundManager::update_background()
 
     if (music_state && vec_streams.size() > 0 && !al_get_audio_stream_playing(vec_streams.front()))
     {
+        GIO_TRACE_SCOPE("SoundManager::next_track");
+
         ALLEGRO_AUDIO_STREAM* stream = vec_streams.front();
         al_rewind_audio_stream(stream);
         vec_streams.erase(vec_streams.begin(), vec_streams.begin() + 1);
@@ -0,0 +1,20 @@
+#ifndef STEP_TIMINGS_H
+#define STEP_TIMINGS_H
+
+#include <cstddef>
+
+/**
+ * @brief the time spent in each phase of a physics step, summed over its substeps, in seconds
+ */
+struct StepTimings
+{
+    bool valid = false;
+
+    double pre_step = 0.0;
+    double step = 0.0;
+    double post_step = 0.0;
+
+    size_t substeps = 0;
+};
+
+#endif // STEP_TIMINGS_H
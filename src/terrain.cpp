@@ -1,139 +1,535 @@
 #include "terrain.h"
 
+#include <gamelib/trace.h>
+
+#ifndef GIO_HEADLESS
 #include <allegro5/allegro.h>
 #include <allegro5/allegro_primitives.h>
+#endif
 
-#include <gamelib/polygon.h>
-
+#include <algorithm>
+#include <cassert>
 #include <cmath>
-#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define GIO_TERRAIN_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace
+{
+    /**
+     * @brief the distance between terrain samples, in pixels, which is short enough that linear
+     * interpolation follows the shortest noise octave closely
+     */
+    const double SAMPLE_SPACING = 2.0;
+    const double INV_SAMPLE_SPACING = 1.0 / SAMPLE_SPACING;
+
+    /**
+     * @brief the number of sample intervals within each terrain chunk, as a power of two so that the
+     * chunk and sample within it are found with a shift and a mask
+     */
+    const int CHUNK_SHIFT = 8;
+    const long CHUNK_SAMPLES = 1L << CHUNK_SHIFT;
+    const long CHUNK_MASK = CHUNK_SAMPLES - 1;
+
+    /**
+     * @brief the number of chunks held in the cache, as a power of two, which covers the width spanned
+     * by a scene of many balloons so that balloons far apart do not keep evicting each other's chunks.
+     * Chunks are only allocated once they are first filled
+     */
+    const long CHUNK_SLOTS = 256;
+    const long CHUNK_SLOT_MASK = CHUNK_SLOTS - 1;
+
+    /**
+     * @brief the distance the highest point of a bounds query is raised, in pixels, to cover any
+     * rounding in the interpolated heights
+     */
+    const double BOUNDS_TOLERANCE = 1e-6;
+
+    /**
+     * @brief rounds down to an integer, without the library call that std::floor needs on targets
+     * without a rounding instruction
+     * @param value the value to round
+     * @return the rounded-down value
+     */
+    inline long floor_to_long(const double value)
+    {
+        const long truncated = static_cast<long>(value);
+        return (value < static_cast<double>(truncated)) ? truncated - 1 : truncated;
+    }
+}
+
+#ifndef GIO_HEADLESS
+namespace
+{
+    /**
+     * @brief the width of each terrain tile, in pixels
+     */
+    const int TILE_WIDTH = 256;
+
+    /**
+     * @brief the height of each terrain tile, in pixels, which must cover the range of surface heights
+     * within the width of a tile
+     */
+    const int TILE_HEIGHT = 512;
+
+    /**
+     * @brief the space left above the highest surface point of each tile, in pixels
+     */
+    const double TILE_MARGIN = 8.0;
+
+    /**
+     * @brief provides the index of the tile column containing the given x location
+     * @param x the x location
+     * @return the tile column index, counted in tile widths from x = 0
+     */
+    long tile_index_at_x(const double x)
+    {
+        return static_cast<long>(std::floor(x / static_cast<double>(TILE_WIDTH)));
+    }
+}
+#endif
 
 Terrain::Terrain() :
-    bitmap(nullptr)
+    Terrain(TerrainSettings())
 {
-    // Initialize constants
-    base_height = 650.0;
+    // Empty Constructor
+}
 
+Terrain::Terrain(const TerrainSettings& settings) :
+    generator(settings),
+    tile_update_count(0)
+{
+    // Initialize constants
     spring_constant = 500.0;
     damping_coefficient = 250.0;
     friction_damping = 100.0;
 
-    base_amplitude = 20.0;
-    base_frequency = 0.01;
+    // Define the empty chunk cache
+    chunks.resize(static_cast<size_t>(CHUNK_SLOTS));
+}
+
+#ifdef GIO_HEADLESS
+void Terrain::draw(const DrawState*)
+{
+    // Nothing to draw without a display
 }
 
+void Terrain::invalidate_draw(const DrawState*)
+{
+    // Nothing to invalidate without a display
+}
+#else
 void Terrain::draw(const DrawState* state)
 {
     // Extract the height and width
-    const int display_width = static_cast<int>(state->screen_w);
-    const int display_height = static_cast<int>(state->screen_h);
+    const double display_width = static_cast<double>(state->screen_w);
+    const double display_height = static_cast<double>(state->screen_h);
 
-    const double display_width_d = static_cast<double>(display_width);
-    const double display_height_d = static_cast<double>(display_height);
+    // Size the ring to hold every tile that can be visible at once, plus a spare, so that the
+    // memory used depends only on the display width
+    const size_t tile_count = static_cast<size_t>(std::ceil(display_width / static_cast<double>(TILE_WIDTH))) + 2;
+    if (tiles.size() != tile_count)
+    {
+        clear_tiles();
+        tiles.resize(tile_count);
+    }
 
-    // Define the current draw offset difference
-    const Vector2 offset_diff = state->draw_offset - bitmap_offset;
-    const double tol_thresh = 0.95;
-    const bool x_requires_redraw = offset_diff.x < -tol_thresh * display_width || offset_diff.x > tol_thresh * display_width;
-    const bool y_requires_redraw = offset_diff.y < -tol_thresh * display_height || offset_diff.y > tol_thresh * display_height;
+    const ALLEGRO_COLOR ground_color = al_map_rgb(50, 150, 75);
 
-    const bool redraw_bitmap = bitmap == nullptr || x_requires_redraw || y_requires_redraw;
+    // Draw each visible tile column, redrawing only the columns which have scrolled into view
+    const long first_index = tile_index_at_x(state->draw_offset.x);
+    const long last_index = tile_index_at_x(state->draw_offset.x + display_width);
+    const long ring_size = static_cast<long>(tiles.size());
 
-    // Update the bitmap if needed
-    if (redraw_bitmap)
+    for (long index = first_index; index <= last_index; ++index)
     {
-        // Create the bitmap if needed
-        if (bitmap == nullptr)
+        // Each column has a fixed slot in the ring, so a slot is only reused once the column it
+        // held has scrolled out of view
+        TerrainTile& tile = tiles[static_cast<size_t>(((index % ring_size) + ring_size) % ring_size)];
+
+        if (!tile.valid || tile.index != index)
         {
-            bitmap = al_create_bitmap(
-                display_width * 3,
-                display_height * 3);
+            update_tile(tile, index);
         }
 
-        // Update the bitmap
-        ALLEGRO_BITMAP* prev_target = al_get_target_bitmap();
-        al_set_target_bitmap(bitmap);
+        if (!tile.valid)
+        {
+            continue;
+        }
 
-        al_clear_to_color(al_map_rgba(0, 0, 0, 0));
+        // Draw the tile bitmap
+        const float screen_x = static_cast<float>(static_cast<double>(index * TILE_WIDTH) - state->draw_offset.x);
+        const float screen_y = static_cast<float>(tile.top - state->draw_offset.y);
 
-        bitmap_offset = state->draw_offset;
+        al_draw_bitmap(
+            tile.bitmap,
+            screen_x,
+            screen_y,
+            0);
 
-        // Clear the resulting points
-        terrain_points.clear();
+        // Fill the ground below the tile down to the bottom of the screen
+        const float fill_top = screen_y + static_cast<float>(TILE_HEIGHT);
+        if (fill_top < static_cast<float>(display_height))
+        {
+            al_draw_filled_rectangle(
+                screen_x,
+                fill_top,
+                screen_x + static_cast<float>(TILE_WIDTH),
+                static_cast<float>(display_height),
+                ground_color);
+        }
+    }
+}
 
-        const Vector2 draw_offset = Vector2(
-            -display_width_d,
-            -display_height_d);
+void Terrain::invalidate_draw(const DrawState*)
+{
+    clear_tiles();
+}
 
-        // Define points
-        const Vector2 display_bottom_left = Vector2(
-            -display_width_d,
-            2.0 * display_height_d) - draw_offset;
-        const Vector2 display_bottom_right = Vector2(
-            2.0 * display_width_d,
-            2.0 * display_height_d) - draw_offset;
+void Terrain::update_tile(
+    TerrainTile& tile,
+    const long index)
+{
+    GIO_TRACE_SCOPE("Terrain::update_tile");
 
-        // Add the bottom-right surface
-        terrain_points.add_point(display_bottom_right);
+    // Create the bitmap once, and reuse it for each column the tile covers afterwards
+    if (tile.bitmap == nullptr)
+    {
+        tile.bitmap = al_create_bitmap(TILE_WIDTH, TILE_HEIGHT);
+    }
 
-        // Iterate over each point to assign to the results
-        for (int i = 2 * display_width; i >= -display_width; --i)
-        {
-            // Define the x location
-            const double x_loc = static_cast<double>(i + bitmap_offset.x);
+    tile.index = index;
+    tile.valid = tile.bitmap != nullptr;
 
-            // Define the vector point to add
-            Vector2 poly_point = Vector2(
-                x_loc,
-                elevation_at_x(x_loc)) - draw_offset - bitmap_offset;
+    if (!tile.valid)
+    {
+        return;
+    }
 
-            // Add the point to the terrain items
-            terrain_points.add_point(poly_point);
-        }
+    ++tile_update_count;
 
-        // Add the final point
-        terrain_points.add_point(display_bottom_left);
+    // Define the polygon as the bottom-right corner, the surface from right to left with one point
+    // per pixel column including the edge shared with the next tile, and the bottom-left corner
+    const size_t surface_points = static_cast<size_t>(TILE_WIDTH) + 1;
+    tile_vertices.resize((surface_points + 2) * 2);
 
-        // Obtain the allegro points to use
-        const std::vector<float> al_points = terrain_points.get_allegro_points();
+    const double tile_x = static_cast<double>(index * TILE_WIDTH);
+    double highest_point = 0.0;
 
-        // Draw the terrain polygon
-        al_draw_filled_polygon(
-            al_points.data(),
-            static_cast<int>(terrain_points.size()),
-            al_map_rgb(50, 150, 75));
+    for (size_t i = 0; i < surface_points; ++i)
+    {
+        const double elevation = generator.elevation_at_x(tile_x + static_cast<double>(i));
+        highest_point = (i == 0) ? elevation : std::min(highest_point, elevation);
+
+        const size_t vertex = surface_points - i;
+        tile_vertices[vertex * 2] = static_cast<float>(i);
+        tile_vertices[vertex * 2 + 1] = static_cast<float>(elevation);
+    }
+
+    // Place the tile just above the highest surface point, and move the surface into tile coordinates
+    tile.top = highest_point - TILE_MARGIN;
 
-        // Reset the draw target
-        al_set_target_bitmap(prev_target);
+    for (size_t vertex = 1; vertex <= surface_points; ++vertex)
+    {
+        tile_vertices[vertex * 2 + 1] -= static_cast<float>(tile.top);
     }
 
-    // Draw the bitmap
-    al_draw_bitmap(
-        bitmap,
-        bitmap_offset.x - state->draw_offset.x - display_width_d,
-        bitmap_offset.y - state->draw_offset.y - display_height_d,
-        0);
+    tile_vertices[0] = static_cast<float>(TILE_WIDTH);
+    tile_vertices[1] = static_cast<float>(TILE_HEIGHT);
+    tile_vertices[(surface_points + 1) * 2] = 0.0f;
+    tile_vertices[(surface_points + 1) * 2 + 1] = static_cast<float>(TILE_HEIGHT);
+
+    // Draw the terrain polygon into the tile
+    ALLEGRO_BITMAP* prev_target = al_get_target_bitmap();
+    al_set_target_bitmap(tile.bitmap);
+
+    al_clear_to_color(al_map_rgba(0, 0, 0, 0));
+
+    al_draw_filled_polygon(
+        tile_vertices.data(),
+        static_cast<int>(surface_points + 2),
+        al_map_rgb(50, 150, 75));
+
+    // Reset the draw target
+    al_set_target_bitmap(prev_target);
 }
 
-void Terrain::invalidate_draw(const DrawState* state)
+void Terrain::clear_tiles()
 {
-    if (bitmap != nullptr)
+    for (TerrainTile& tile : tiles)
     {
-        al_destroy_bitmap(bitmap);
-        bitmap = nullptr;
+        if (tile.bitmap != nullptr)
+        {
+            al_destroy_bitmap(tile.bitmap);
+            tile.bitmap = nullptr;
+        }
     }
+
+    tiles.clear();
 }
+#endif
 
 double Terrain::elevation_at_x(const double x)
 {
-    return base_height + base_amplitude * std::sin(base_frequency * x);
+    // Find the sample interval containing the location
+    const double position = x * INV_SAMPLE_SPACING;
+    const long sample_index = floor_to_long(position);
+
+    const TerrainChunk& chunk = chunk_at(sample_index >> CHUNK_SHIFT);
+    const size_t i = static_cast<size_t>(sample_index & CHUNK_MASK);
+
+    // Interpolate between the samples on either side
+    const double t = position - static_cast<double>(sample_index);
+    return chunk.heights[i] + (chunk.heights[i + 1] - chunk.heights[i]) * t;
 }
 
 Vector2 Terrain::surface_normal_at_x(const double x)
 {
+    // Find the sample interval containing the location
+    const double position = x * INV_SAMPLE_SPACING;
+    const long sample_index = floor_to_long(position);
+
+    const TerrainChunk& chunk = chunk_at(sample_index >> CHUNK_SHIFT);
+    const size_t i = static_cast<size_t>(sample_index & CHUNK_MASK);
+
+    // Interpolate between the normals on either side, and restore the unit length
+    const double t = position - static_cast<double>(sample_index);
     return Vector2(
-        base_amplitude * base_frequency * std::cos(base_frequency * x),
-        -1.0).normalize();
+        chunk.normal_x[i] + (chunk.normal_x[i + 1] - chunk.normal_x[i]) * t,
+        chunk.normal_y[i] + (chunk.normal_y[i + 1] - chunk.normal_y[i]) * t).normalize();
+}
+
+void Terrain::sample(
+    gio::Span<const double> xs,
+    gio::Span<double> heights,
+    gio::Span<Vector2> normals)
+{
+    const size_t count = xs.size();
+    assert(heights.empty() || heights.size() >= count);
+    assert(normals.empty() || normals.size() >= count);
+
+    const bool sample_heights = !heights.empty();
+    const bool sample_normals = !normals.empty();
+
+    size_t begin = 0;
+    while (begin < count)
+    {
+        // Find the run of locations which share the chunk of the first location. The chunk covers a
+        // whole number of sample intervals, so the positions within it are found by comparing against
+        // its first and last sample rather than rounding each position
+        const long chunk_index = floor_to_long(xs[begin] * INV_SAMPLE_SPACING) >> CHUNK_SHIFT;
+        const double chunk_first = static_cast<double>(chunk_index * CHUNK_SAMPLES);
+        const double chunk_last = chunk_first + static_cast<double>(CHUNK_SAMPLES);
+
+        size_t end = begin + 1;
+        while (end < count)
+        {
+            const double position = xs[end] * INV_SAMPLE_SPACING;
+            if (position < chunk_first || !(position < chunk_last))
+            {
+                break;
+            }
+            ++end;
+        }
+
+        const TerrainChunk& chunk = chunk_at(chunk_index);
+        size_t j = begin;
+
+#if defined(GIO_TERRAIN_SSE2)
+        // Interpolate two locations at a time. Each pair of neighbouring samples is one load, split
+        // into the lower and upper samples of both lanes, and the arithmetic is in the same order as
+        // the scalar expressions so that both give the same values
+        const __m128d inv_spacing = _mm_set1_pd(INV_SAMPLE_SPACING);
+        for (; j + 2 <= end; j += 2)
+        {
+            const __m128d position = _mm_mul_pd(_mm_loadu_pd(&xs[j]), inv_spacing);
+            const long sample_index_0 = floor_to_long(xs[j] * INV_SAMPLE_SPACING);
+            const long sample_index_1 = floor_to_long(xs[j + 1] * INV_SAMPLE_SPACING);
+            const size_t i_0 = static_cast<size_t>(sample_index_0 & CHUNK_MASK);
+            const size_t i_1 = static_cast<size_t>(sample_index_1 & CHUNK_MASK);
+            const __m128d t = _mm_sub_pd(position, _mm_set_pd(
+                static_cast<double>(sample_index_1),
+                static_cast<double>(sample_index_0)));
+
+            if (sample_heights)
+            {
+                const __m128d pair_0 = _mm_loadu_pd(&chunk.heights[i_0]);
+                const __m128d pair_1 = _mm_loadu_pd(&chunk.heights[i_1]);
+                const __m128d lower = _mm_unpacklo_pd(pair_0, pair_1);
+                const __m128d upper = _mm_unpackhi_pd(pair_0, pair_1);
+                _mm_storeu_pd(&heights[j], _mm_add_pd(lower, _mm_mul_pd(_mm_sub_pd(upper, lower), t)));
+            }
+
+            if (sample_normals)
+            {
+                const __m128d pair_x_0 = _mm_loadu_pd(&chunk.normal_x[i_0]);
+                const __m128d pair_x_1 = _mm_loadu_pd(&chunk.normal_x[i_1]);
+                const __m128d pair_y_0 = _mm_loadu_pd(&chunk.normal_y[i_0]);
+                const __m128d pair_y_1 = _mm_loadu_pd(&chunk.normal_y[i_1]);
+                const __m128d lower_x = _mm_unpacklo_pd(pair_x_0, pair_x_1);
+                const __m128d upper_x = _mm_unpackhi_pd(pair_x_0, pair_x_1);
+                const __m128d lower_y = _mm_unpacklo_pd(pair_y_0, pair_y_1);
+                const __m128d upper_y = _mm_unpackhi_pd(pair_y_0, pair_y_1);
+                const __m128d x = _mm_add_pd(lower_x, _mm_mul_pd(_mm_sub_pd(upper_x, lower_x), t));
+                const __m128d y = _mm_add_pd(lower_y, _mm_mul_pd(_mm_sub_pd(upper_y, lower_y), t));
+
+                // Restore the unit length, and interleave the lanes back into one vector per location
+                const __m128d magnitude = _mm_sqrt_pd(_mm_add_pd(_mm_mul_pd(x, x), _mm_mul_pd(y, y)));
+                const __m128d unit_x = _mm_div_pd(x, magnitude);
+                const __m128d unit_y = _mm_div_pd(y, magnitude);
+                _mm_storeu_pd(&normals[j].x, _mm_unpacklo_pd(unit_x, unit_y));
+                _mm_storeu_pd(&normals[j + 1].x, _mm_unpackhi_pd(unit_x, unit_y));
+            }
+        }
+#endif
+
+        // Interpolate the remaining locations within the run one at a time
+        for (; j < end; ++j)
+        {
+            const double position = xs[j] * INV_SAMPLE_SPACING;
+            const long sample_index = floor_to_long(position);
+            const size_t i = static_cast<size_t>(sample_index & CHUNK_MASK);
+            const double t = position - static_cast<double>(sample_index);
+
+            if (sample_heights)
+            {
+                heights[j] = chunk.heights[i] + (chunk.heights[i + 1] - chunk.heights[i]) * t;
+            }
+
+            if (sample_normals)
+            {
+                normals[j] = Vector2(
+                    chunk.normal_x[i] + (chunk.normal_x[i + 1] - chunk.normal_x[i]) * t,
+                    chunk.normal_y[i] + (chunk.normal_y[i + 1] - chunk.normal_y[i]) * t).normalize();
+            }
+        }
+
+        begin = end;
+    }
+}
+
+double Terrain::highest_point_between(
+    const double x_min,
+    const double x_max)
+{
+    double highest_elevation = 0.0;
+
+    const long first_sample = floor_to_long(x_min * INV_SAMPLE_SPACING);
+    const long last_sample = floor_to_long(x_max * INV_SAMPLE_SPACING);
+    const long first_chunk = first_sample >> CHUNK_SHIFT;
+    const long last_chunk = last_sample >> CHUNK_SHIFT;
+
+    bool first = true;
+
+    for (long chunk_index = first_chunk; chunk_index <= last_chunk; ++chunk_index)
+    {
+        const TerrainChunk& chunk = chunk_at(chunk_index);
+
+        // Walk the min-tree up from the leaves of the intervals covered within this chunk
+        size_t left = static_cast<size_t>((chunk_index == first_chunk) ? (first_sample & CHUNK_MASK) : 0) + static_cast<size_t>(CHUNK_SAMPLES);
+        size_t right = static_cast<size_t>((chunk_index == last_chunk) ? (last_sample & CHUNK_MASK) : CHUNK_MASK) + static_cast<size_t>(CHUNK_SAMPLES) + 1;
+
+        double highest = chunk.highest_tree[left];
+        while (left < right)
+        {
+            if ((left & 1) != 0)
+            {
+                highest = std::min(highest, chunk.highest_tree[left++]);
+            }
+            if ((right & 1) != 0)
+            {
+                highest = std::min(highest, chunk.highest_tree[--right]);
+            }
+
+            left >>= 1;
+            right >>= 1;
+        }
+
+        highest_elevation = first ? highest : std::min(highest_elevation, highest);
+        first = false;
+    }
+
+    return highest_elevation - BOUNDS_TOLERANCE;
+}
+
+double Terrain::get_sample_spacing() const
+{
+    return SAMPLE_SPACING;
+}
+
+const TerrainSettings& Terrain::get_settings() const
+{
+    return generator.get_settings();
+}
+
+size_t Terrain::get_tile_update_count() const
+{
+    return tile_update_count;
+}
+
+const TerrainChunk& Terrain::chunk_at(const long index)
+{
+    // Each chunk has a fixed slot in the cache, and replaces whichever chunk was there before
+    TerrainChunk& chunk = chunks[static_cast<size_t>(index & CHUNK_SLOT_MASK)];
+
+    if (!chunk.valid || chunk.index != index)
+    {
+        fill_chunk(chunk, index);
+    }
+
+    return chunk;
+}
+
+void Terrain::fill_chunk(
+    TerrainChunk& chunk,
+    const long index)
+{
+    GIO_TRACE_SCOPE("Terrain::fill_chunk");
+
+    const size_t point_count = static_cast<size_t>(CHUNK_SAMPLES) + 1;
+
+    chunk.heights.resize(point_count);
+    chunk.normal_x.resize(point_count);
+    chunk.normal_y.resize(point_count);
+    chunk.highest_tree.resize(2 * static_cast<size_t>(CHUNK_SAMPLES));
+
+    // Sample the surface with one extra sample on each side, so that every normal is a central difference
+    chunk_samples.resize(point_count + 2);
+
+    const long first_sample = index * CHUNK_SAMPLES - 1;
+    for (size_t i = 0; i < chunk_samples.size(); ++i)
+    {
+        chunk_samples[i] = generator.elevation_at_x(static_cast<double>(first_sample + static_cast<long>(i)) * SAMPLE_SPACING);
+    }
+
+    for (size_t i = 0; i < point_count; ++i)
+    {
+        const double slope = (chunk_samples[i + 2] - chunk_samples[i]) / (2.0 * SAMPLE_SPACING);
+        const Vector2 normal = Vector2(slope, -1.0).normalize();
+
+        chunk.heights[i] = chunk_samples[i + 1];
+        chunk.normal_x[i] = normal.x;
+        chunk.normal_y[i] = normal.y;
+    }
+
+    // Build the min-tree of the highest point within each interval, which is the higher of its two
+    // end samples since the surface is interpolated linearly between them
+    const size_t leaf_offset = static_cast<size_t>(CHUNK_SAMPLES);
+
+    for (size_t i = 0; i < leaf_offset; ++i)
+    {
+        chunk.highest_tree[leaf_offset + i] = std::min(chunk.heights[i], chunk.heights[i + 1]);
+    }
+
+    for (size_t node = leaf_offset - 1; node > 0; --node)
+    {
+        chunk.highest_tree[node] = std::min(chunk.highest_tree[2 * node], chunk.highest_tree[2 * node + 1]);
+    }
+
+    chunk.index = index;
+    chunk.valid = true;
 }
 
 double Terrain::get_spring_constant() const
@@ -153,9 +549,7 @@ double Terrain::get_frictional_cofficient() const
 
 Terrain::~Terrain()
 {
-    if (bitmap != nullptr)
-    {
-        al_destroy_bitmap(bitmap);
-        bitmap = nullptr;
-    }
+#ifndef GIO_HEADLESS
+    clear_tiles();
+#endif
 }
@@ -2,17 +2,57 @@
 #define TERRAIN_H
 
 #include <gamelib/draw_object.h>
+#include <gamelib/height_field.h>
+#include <gamelib/span.h>
 #include <gamelib/vector2.h>
 
-#include <gamelib/polygon.h>
+#include <terrain_generator.h>
 
-#include <allegro5/allegro.h>
+#include <cstddef>
+#include <vector>
 
-class Terrain : public DrawObject
+struct ALLEGRO_BITMAP;
+
+/**
+ * @brief a fixed-width bitmap of the terrain surface, covering one column of the world
+ */
+struct TerrainTile
+{
+    long index = 0;
+    double top = 0.0;
+    bool valid = false;
+    ALLEGRO_BITMAP* bitmap = nullptr;
+};
+
+/**
+ * @brief a fixed-width run of terrain samples, holding the surface height and normal at each sample
+ * point including the point shared with the next chunk. The highest point of each sample interval is
+ * also held in a min-tree, with the leaves after the internal nodes, so that the highest point over
+ * any range of intervals is found in logarithmic time
+ */
+struct TerrainChunk
+{
+    long index = 0;
+    bool valid = false;
+    std::vector<double> heights;
+    std::vector<double> normal_x;
+    std::vector<double> normal_y;
+
+    std::vector<double> highest_tree;
+};
+
+/**
+ * @brief The procedural terrain. The surface is sampled from the terrain generator at a fixed spacing
+ * into chunks held in a small direct-mapped cache, so that each height and normal lookup is a cache
+ * slot check and a linear interpolation between two samples rather than an evaluation of every noise octave
+ */
+class Terrain : public DrawObject, public HeightField
 {
 public:
     Terrain();
 
+    explicit Terrain(const TerrainSettings& settings);
+
     virtual void draw(const DrawState* state) override;
 
     virtual void invalidate_draw(const DrawState* state) override;
@@ -21,28 +61,96 @@ public:
 
     Vector2 surface_normal_at_x(const double x);
 
+    /**
+     * @brief samples the surface at several locations in one call, giving the same values as
+     * elevation_at_x and surface_normal_at_x. The cached chunk is found once for each run of
+     * consecutive locations within the same chunk, so a body pays for the terrain once per step
+     * rather than once per point and query. An output span is either empty or holds a value for
+     * every location
+     * @param xs the x locations to sample
+     * @param heights set to the surface y coordinate at each location, or empty to skip
+     * @param normals set to the unit surface normal at each location, or empty to skip
+     */
+    virtual void sample(
+        gio::Span<const double> xs,
+        gio::Span<double> heights,
+        gio::Span<Vector2> normals) override;
+
+    /**
+     * @brief finds the highest point of the surface between two x locations, for culling contact
+     * tests that cannot touch the ground
+     * @param x_min the smallest x location
+     * @param x_max the largest x location
+     * @return the smallest surface y coordinate in the range, which is never below the surface
+     * returned by elevation_at_x
+     */
+    virtual double highest_point_between(
+        const double x_min,
+        const double x_max) override;
+
+    virtual double get_sample_spacing() const override;
+
     double get_spring_constant() const;
 
     double get_damping_coefficient() const;
 
     double get_frictional_cofficient() const;
 
+    const TerrainSettings& get_settings() const;
+
+    /**
+     * @brief provides the number of times a tile bitmap has been redrawn, for performance reporting
+     * @return the total tile redraw count
+     */
+    size_t get_tile_update_count() const;
+
     ~Terrain();
 
 protected:
-    double base_height;
-
     double spring_constant;
     double damping_coefficient;
     double friction_damping;
 
-    double base_amplitude;
-    double base_frequency;
+    TerrainGenerator generator;
+
+private:
+    /**
+     * @brief provides the cached chunk with the given index, sampling it into its cache slot if needed
+     * @param index the index of the chunk, counted in chunk widths from x = 0
+     * @return the chunk
+     */
+    const TerrainChunk& chunk_at(const long index);
+
+    /**
+     * @brief samples the surface heights and normals of a chunk from the generator
+     * @param chunk the chunk to fill
+     * @param index the index of the chunk, counted in chunk widths from x = 0
+     */
+    void fill_chunk(
+        TerrainChunk& chunk,
+        const long index);
+
+    /**
+     * @brief redraws a tile bitmap to cover the given tile column, creating the bitmap if needed
+     * @param tile the tile to update
+     * @param index the index of the tile column, counted in tile widths from x = 0
+     */
+    void update_tile(
+        TerrainTile& tile,
+        const long index);
+
+    /**
+     * @brief destroys all tile bitmaps and empties the tile ring
+     */
+    void clear_tiles();
 
 private:
-    Polygon terrain_points;
-    Vector2 bitmap_offset;
-    ALLEGRO_BITMAP* bitmap;
+    std::vector<TerrainChunk> chunks;
+    std::vector<double> chunk_samples;
+
+    std::vector<TerrainTile> tiles;
+    std::vector<float> tile_vertices;
+    size_t tile_update_count;
 };
 
 #endif // TERRAIN_H
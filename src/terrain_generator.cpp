@@ -0,0 +1,92 @@
+#include "terrain_generator.h"
+
+#include <cmath>
+
+namespace
+{
+    /**
+     * @brief mixes a 64-bit value with the SplitMix64 finalizer, so that neighboring inputs give
+     * unrelated outputs
+     * @param value the value to mix
+     * @return the mixed value
+     */
+    uint64_t mix_bits(uint64_t value)
+    {
+        value += 0x9e3779b97f4a7c15ull;
+        value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ull;
+        value = (value ^ (value >> 27)) * 0x94d049bb133111ebull;
+        return value ^ (value >> 31);
+    }
+
+    /**
+     * @brief provides the random gradient at a lattice point
+     * @param octave_seed the seed of the octave
+     * @param lattice_index the lattice point
+     * @return the gradient, between -1 and 1
+     */
+    double lattice_gradient(
+        const uint64_t octave_seed,
+        const int64_t lattice_index)
+    {
+        const uint64_t bits = mix_bits(octave_seed ^ mix_bits(static_cast<uint64_t>(lattice_index)));
+        return static_cast<double>(bits >> 11) * (2.0 / 9007199254740992.0) - 1.0;
+    }
+}
+
+TerrainGenerator::TerrainGenerator()
+{
+    // Empty Constructor
+}
+
+TerrainGenerator::TerrainGenerator(const TerrainSettings& settings) :
+    settings(settings)
+{
+    // Empty Constructor
+}
+
+const TerrainSettings& TerrainGenerator::get_settings() const
+{
+    return settings;
+}
+
+double TerrainGenerator::elevation_at_x(const double x) const
+{
+    // Sum each octave, shortening the wavelength and reducing the amplitude of each octave in turn
+    double height = 0.0;
+    double amplitude = settings.amplitude;
+    double frequency = 1.0 / settings.wavelength;
+
+    for (size_t octave = 0; octave < settings.octaves; ++octave)
+    {
+        const uint64_t octave_seed = mix_bits(settings.seed + static_cast<uint64_t>(octave));
+        height += amplitude * gradient_noise(octave_seed, x * frequency);
+
+        amplitude *= settings.persistence;
+        frequency *= settings.lacunarity;
+    }
+
+    // Flatten the hilltops above the plateau height
+    if (height > settings.plateau_height)
+    {
+        height = settings.plateau_height + (height - settings.plateau_height) * settings.plateau_flatness;
+    }
+
+    // Convert the height into a screen coordinate, where up is negative
+    return settings.base_height - height;
+}
+
+double TerrainGenerator::gradient_noise(
+    const uint64_t octave_seed,
+    const double x)
+{
+    const double lattice = std::floor(x);
+    const double t = x - lattice;
+    const int64_t index = static_cast<int64_t>(lattice);
+
+    // Blend the ramps from the gradients on either side with a smooth quintic fade
+    const double ramp_left = lattice_gradient(octave_seed, index) * t;
+    const double ramp_right = lattice_gradient(octave_seed, index + 1) * (t - 1.0);
+    const double fade = t * t * t * (t * (t * 6.0 - 15.0) + 10.0);
+
+    return 2.0 * (ramp_left + fade * (ramp_right - ramp_left));
+}
@@ -0,0 +1,71 @@
+#ifndef TERRAIN_GENERATOR_H
+#define TERRAIN_GENERATOR_H
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief Provides the parameters of the procedural terrain, with heights in pixels measured upwards
+ * from the base height
+ */
+struct TerrainSettings
+{
+    uint64_t seed = 1;
+
+    double base_height = 650.0;
+
+    double amplitude = 60.0;
+    double wavelength = 1600.0;
+    size_t octaves = 6;
+    double persistence = 0.45;
+    double lacunarity = 2.0;
+
+    double plateau_height = 45.0;
+    double plateau_flatness = 0.2;
+};
+
+/**
+ * @brief Generates a deterministic terrain profile from the sum of several octaves of seeded 1D
+ * gradient noise. Each octave halves the wavelength of the one before it, so that the first octaves
+ * form long hills and valleys and the later octaves add rougher detail, and heights above the plateau
+ * height are compressed to form flat hilltops. The same settings always produce the same terrain
+ */
+class TerrainGenerator
+{
+public:
+    /**
+     * @brief constructs a generator with the default settings
+     */
+    TerrainGenerator();
+
+    /**
+     * @brief constructs a generator with the given settings
+     * @param settings the terrain settings
+     */
+    explicit TerrainGenerator(const TerrainSettings& settings);
+
+    const TerrainSettings& get_settings() const;
+
+    /**
+     * @brief evaluates the terrain surface directly from the noise octaves
+     * @param x the x location
+     * @return the y coordinate of the terrain surface, in screen coordinates
+     */
+    double elevation_at_x(const double x) const;
+
+protected:
+    /**
+     * @brief evaluates one octave of gradient noise, with a new random gradient at each integer lattice point
+     * @param octave_seed the seed of the octave
+     * @param x the location, in lattice units
+     * @return the noise value, approximately between -1 and 1
+     */
+    static double gradient_noise(
+        const uint64_t octave_seed,
+        const double x);
+
+protected:
+    TerrainSettings settings;
+};
+
+#endif // TERRAIN_GENERATOR_H
@@ -5,9 +5,20 @@
 
 #include <terrain.h>
 
+/**
+ * @brief the methods available to keep rope lengths within their limits
+ */
+enum class RopeMode
+{
+    SPRING,
+    CONSTRAINT
+};
+
 struct WorldState : PhysicsState
 {
     Terrain* terrain = nullptr;
+
+    RopeMode rope_mode = RopeMode::SPRING;
 };
 
 #endif // WORLD_STATE_H